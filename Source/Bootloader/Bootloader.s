@@ -41,6 +41,10 @@
 	Essentially this code does nothing more than loading the
 	kernel from disk into memory and passing control to it.
 
+	The kernel is loaded to 0x1000 and may extend beyond 0x7c00,
+	so the bootloader first moves itself (and its stack) below
+	the kernel.
+
 	*/
 
 
@@ -48,14 +52,28 @@
 	.section .text
 
 
+	// Bootloader address definitions
+	.equ BootloaderLoadAddress, 0x7c00
+	.equ BootloaderAddress, 0x0600
+
 	// Stack address definitions
-	.equ StackBottom, 0x7e00
-	.equ StackTop, 0x7fff
+	.equ StackBottom, 0x0800
+	.equ StackTop, 0x0ffe
 
 	// Kernel address definitions
 	.equ KernelEntryAddress, 0x1000
 	.equ KernelLoadSegment, 0x0100
 
+	// Number of kernel sectors to load (passed by the Makefile,
+	// which also checks that the kernel fits)
+	.ifndef KernelSectorCount
+	.equ KernelSectorCount, 128
+	.endif
+
+	// Floppy disk geometry (1.44 MB)
+	.equ DiskSectorsPerTrack, 18
+	.equ DiskReadAttempts, 3
+
 
 	// MBR entry point
 	.global Bootloader_EntryPoint
@@ -94,6 +112,17 @@ Bootloader_EntryPoint:
 	movw %ax, %ss
 	movw $StackTop, %sp
 
+	// Move out of the way of the kernel and continue there
+	// (the code is linked for its new address)
+
+	movw $BootloaderLoadAddress, %si
+	movw $BootloaderAddress, %di
+	movw $256, %cx
+	cld
+	rep movsw
+
+	ljmp $0, $1f
+1:
 	sti
 
 
@@ -177,58 +206,99 @@ Bootloader_LoadKernel:
 	
 	// Set load destination
 	
-	xorw %ax, %ax
 	movw $KernelLoadSegment, %ax
 	movw %ax, %es
+
+	movw $1, %si			// First kernel sector (LBA)
+	movw $KernelSectorCount, %di	// Sectors left to load
+
+	// Not every BIOS reads across tracks, so the kernel is read
+	// one track (or what is left of it) at a time. A read must
+	// also not cross a 64 KiB boundary, since the floppy DMA
+	// cannot handle that.
+3:
+	// Convert the LBA into a track (AX) and sector index (DX)
+
+	movw %si, %ax
+	xorw %dx, %dx
+	movw $DiskSectorsPerTrack, %bx
+	divw %bx
+
+	// Sectors up to the end of the track
+
+	movw $DiskSectorsPerTrack, %bp
+	subw %dx, %bp
+
+	cmpw %di, %bp
+	jbe 4f
+	movw %di, %bp
+4:
+	// Sectors up to the next 64 KiB boundary (32 paragraphs
+	// per sector)
+
+	movw %es, %bx
+	andw $0x0fff, %bx
+	negw %bx
+	addw $0x1000, %bx
+	shrw $5, %bx
+
+	cmpw %bx, %bp
+	jbe 5f
+	movw %bx, %bp
+5:
+	// Cylinder, head and sector (heads alternate per track)
+
+	movb %dl, %cl
+	incb %cl		// Sector number (1-based)
+	movb %al, %dh
+	andb $1, %dh		// Head number
+	shrw $1, %ax
+	movb %al, %ch		// Cylinder number
+	movb $0, %dl		// Drive number (0 = floppy)
 	xorw %bx, %bx
 
 	// BIOS Function:
-	// Read sectors from disk
+	// Read sectors from disk (reset the drive and try again on
+	// errors, which are common while the motor spins up)
 
+	pushw %di
+	movw $DiskReadAttempts, %di
+6:
+	movw %bp, %ax
 	movb $0x02, %ah		// Function code
+	int $0x13
 
-	// REMARK mju 26-02-16:
-	// Two reads are necessary on vintage systems, because the disk geometry
-	// is 80 sectors per track. Newer BIOS versions can read more than 80
-	// sectors at once, but that's not always the case.
-	
-	movb $48, %al		// Number of sectors to read
-	movb $0, %ch		// Cylinder number
-	movb $2, %cl		// Sector number
-	movb $0, %dh		// Head number
-	movb $0, %dl		// Drive number (0 = floppy)
+	jnc 7f
 
+	xorb %ah, %ah		// Reset disk system
 	int $0x13
 
-	jc 1f
+	decw %di
+	jnz 6b
 
-	// Essentially the same as above
-	
-	xorw  %ax, %ax
-	movw  $KernelLoadSegment, %ax
-	addw  $0x1800, %ax       // 24 KiB / 16 = 0x1800
-	movw  %ax, %es
-	xorw  %bx, %bx
-	
-	movb $0x02, %ah
+	popw %di
+	jmp 1f
+7:
+	popw %di
 
-	movb $49, %al
-	movb $1, %ch
-	movb $1, %cl
-	movb $0, %dh
-	movb $0, %dl
-	
-	int $0x13
+	// Advance behind the sectors just read
+
+	addw %bp, %si
+	subw %bp, %di
+
+	movw %bp, %ax
+	shlw $5, %ax
+	movw %es, %bx
+	addw %ax, %bx
+	movw %bx, %es
 
-	jnc 2f
+	testw %di, %di
+	jnz 3b
+
+	jmp 2f
 	
 1:
-	// Print error message
-	
-	lea BootMessage_LoadError, %si
-	call Bootloader_PrintString
-
-	// Run into trap
+	// Print error message and run into trap
 	
 	call Bootloader_HaltWithError
 	
@@ -255,7 +325,7 @@ Bootloader_HaltWithError:
 
 1:
 	hlt
-	jmp 1
+	jmp 1b
 
 
 
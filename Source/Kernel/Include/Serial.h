@@ -0,0 +1,66 @@
+/*
+	
+  Copyright © 2025 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+
+#ifndef __SERIAL_H__
+#define __SERIAL_H__
+
+#include "../../Modules/Include/SystemCore.h"
+
+
+// The I/O ports of the first two serial interfaces
+#define SERIAL_COM1 0x3f8
+#define SERIAL_COM2 0x2f8
+
+// UART register offsets from the port
+#define SERIAL_DATA 0
+#define SERIAL_INTERRUPT_ENABLE 1
+#define SERIAL_DIVISOR_LOW 0
+#define SERIAL_DIVISOR_HIGH 1
+#define SERIAL_FIFO_CONTROL 2
+#define SERIAL_LINE_CONTROL 3
+#define SERIAL_MODEM_CONTROL 4
+#define SERIAL_LINE_STATUS 5
+
+// Line status: the transmitter holding register is empty
+#define SERIAL_TRANSMIT_EMPTY 0x20
+
+
+module(Serial) {
+
+  // Set up a serial interface for 8 data bits, no parity and one stop
+  // bit at a baud rate (up to 115200). Returns false if the UART does
+  // not respond.
+  bool (*Initialize)(U16 port, U32 baudRate);
+
+  // Send a zero-terminated string, waiting for the transmitter as needed
+  void (*Write)(U16 port, const char *text);
+};
+
+#endif
@@ -0,0 +1,63 @@
+/*
+	
+  Copyright © 2025 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+
+#ifndef __TIMER_H__
+#define __TIMER_H__
+
+#include "../../Modules/Include/SystemCore.h"
+
+
+// The input clock of the PIT (in Hz)
+#define TIMER_CLOCK_FREQUENCY 1193182
+
+// The I/O ports of the PIT
+#define TIMER_PORT_CHANNEL0 0x40
+#define TIMER_PORT_COMMAND 0x43
+
+
+module(Timer) {
+
+  // Program channel 0 of the PIT to interrupt with a frequency (in Hz,
+  // 19 - 1193182) and reset the tick counter
+  void (*Initialize)(U32 frequency);
+
+  // Get the number of timer interrupts since initialization
+  U32 (*GetTicks)(void);
+
+  // Get the number of PIT clocks (~0.84 µs each) since initialization
+  // The value wraps after about an hour; differences stay valid as long
+  // as they are shorter than that.
+  U32 (*GetClocks)(void);
+
+  // Convert a number of PIT clocks to microseconds
+  U32 (*ToMicroseconds)(U32 clocks);
+};
+
+#endif
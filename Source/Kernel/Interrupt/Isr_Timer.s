@@ -30,6 +30,21 @@
 	.global _Isr_Timer
 	.type _Isr_Timer, @function
 
+	.global _Timer_Ticks
+	.type _Timer_Ticks, @object
+
+
+
+	.section .bss
+	.align 4
+
+	// Number of timer interrupts (see Timer.GetTicks)
+
+_Timer_Ticks:
+
+	.long 0
+
+
 
 	.section .text
 
@@ -37,7 +52,7 @@ _Isr_Timer:
 
 	pusha
 
-	// Handler here
+	incl _Timer_Ticks
 
 	movb $0x20, %al
 	outb %al, $0x20
@@ -32,6 +32,8 @@
 #include "../Modules/Include/Memory.h"
 #include "Include/Interrupt.h"
 #include "Include/Keyboard.h"
+#include "Include/Timer.h"
+#include "Include/Serial.h"
 #include "../Modules/GfxTk/Include/GfxTk.h"
 
 
@@ -41,6 +43,8 @@ use(Interrupt);
 use(Heap);
 use(Memory);
 use(String);
+use(Timer);
+use(Serial);
 
 stream inputStream;
 stream outputStream;
@@ -113,14 +117,121 @@ void _HandleInput(void) {
 
 
 
+// ----------------------------------------------------------------------
+// Frame timings
+// ----------------------------------------------------------------------
+
+#define _KERNEL_TIMER_FREQUENCY 1000
+
+// The frame timings are summed up over this many ticks (one second)
+#define _KERNEL_STATS_INTERVAL _KERNEL_TIMER_FREQUENCY
+
+#define _KERNEL_STATS_PORT SERIAL_COM1
+
+// The caret is shown and hidden every this many ticks
+#define _KERNEL_CARET_INTERVAL 500
+
+
+// The parts of a frame that are timed separately
+typedef enum {
+  FrameInput = 0,
+  FrameLayout,
+  FrameDraw,
+  // Includes the wait for the vertical retrace
+  FrameUpload,
+  FrameStageCount
+} FrameStage;
+
+
+typedef struct {
+  // Number of times a stage ran in this interval
+  U32 Count[FrameStageCount];
+  // Total and longest run of a stage (in PIT clocks)
+  U32 Total[FrameStageCount];
+  U32 Longest[FrameStageCount];
+
+  U32 Frames;
+  U32 IntervalStart;
+  U32 StageStart;
+} FrameStats;
+
+static FrameStats _FrameStats;
+static bool _SerialLog;
+
+static char _FrameStatsText[96];
+
+
+extern void KShell_SetFrameStats(const char *text);
+
+
+static inline void _BeginStage(void) {
+  _FrameStats.StageStart = Timer.GetClocks();
+}
+
+
+static inline void _EndStage(FrameStage stage) {
+  U32 clocks = Timer.GetClocks() - _FrameStats.StageStart;
+
+  _FrameStats.Count[stage]++;
+  _FrameStats.Total[stage] += clocks;
+  if (clocks > _FrameStats.Longest[stage])
+    _FrameStats.Longest[stage] = clocks;
+}
+
+
+// Get the average run of a stage (in microseconds)
+static inline U32 _GetAverage(FrameStage stage) {
+  if (!_FrameStats.Count[stage])
+    return 0;
+
+  return Timer.ToMicroseconds(_FrameStats.Total[stage] / _FrameStats.Count[stage]);
+}
+
+
+static inline U32 _GetLongest(FrameStage stage) {
+  return Timer.ToMicroseconds(_FrameStats.Longest[stage]);
+}
+
+
+// Publish the timings of the last interval once it is over
+static void _EndFrame(void) {
+  _FrameStats.Frames++;
+
+  U32 ticks = Timer.GetTicks();
+  if (ticks - _FrameStats.IntervalStart < _KERNEL_STATS_INTERVAL)
+    return;
+
+  // Average and longest time of each stage in microseconds
+  String.FormatN(_FrameStatsText, sizeof(_FrameStatsText),
+		 "%u/%u fr in %u/%u lay %u/%u draw %u/%u up %u/%u",
+		 _FrameStats.Count[FrameDraw], _FrameStats.Frames,
+		 _GetAverage(FrameInput), _GetLongest(FrameInput),
+		 _GetAverage(FrameLayout), _GetLongest(FrameLayout),
+		 _GetAverage(FrameDraw), _GetLongest(FrameDraw),
+		 _GetAverage(FrameUpload), _GetLongest(FrameUpload));
+  KShell_SetFrameStats(_FrameStatsText);
+
+  if (_SerialLog) {
+    Serial.Write(_KERNEL_STATS_PORT, _FrameStatsText);
+    Serial.Write(_KERNEL_STATS_PORT, "\r\n");
+  }
+
+  _FrameStats = (FrameStats) { .IntervalStart = ticks };
+}
+
+
+
 // ----------------------------------------------------------------------
 // Main
 // ----------------------------------------------------------------------
 
+import(Vga);
 import(Renderer);
 
 extern void KShell_Initialize(VgaConfig *config, HeapArea *heap);
+extern bool KShell_UpdateLayout(VgaConfig *config);
 extern void KShell_DrawLayout(VgaConfig *config);
+extern void KShell_BlinkCaret(VgaConfig *config);
 
 VgaConfig vgaConfig;
 
@@ -130,6 +241,8 @@ VgaConfig vgaConfig;
 void KernelMain() {
   _InitializeHeap();
   Interrupt.SetUpAll(_Kernel_Idt, &_Kernel_IdtDescriptor);
+  Timer.Initialize(_KERNEL_TIMER_FREQUENCY);
+  _SerialLog = Serial.Initialize(_KERNEL_STATS_PORT, 115200);
 
   vgaConfig = (VgaConfig) {
     .Resolution = (Vector2d) {
@@ -142,15 +255,40 @@ void KernelMain() {
   };
 
   KShell_Initialize(&vgaConfig, _Kernel_DynMemory);
+  U32 caretToggled = Timer.GetTicks();
 
   for (;;) {
+    _BeginStage();
     _ProcessKeyboardInput();
     _HandleInput();
-
-    KShell_DrawLayout(&vgaConfig);
-    Renderer.Refresh(&vgaConfig);
-    
-   
+    _EndStage(FrameInput);
+
+    // Nothing is drawn or uploaded unless something changed
+    _BeginStage();
+    bool redraw = KShell_UpdateLayout(&vgaConfig);
+    _EndStage(FrameLayout);
+
+    if (redraw) {
+      _BeginStage();
+      KShell_DrawLayout(&vgaConfig);
+      _EndStage(FrameDraw);
+    }
+
+    if (vgaConfig.DirtyCount || Vga.HasQueuedPalette()) {
+      _BeginStage();
+      Renderer.Refresh(&vgaConfig);
+      _EndStage(FrameUpload);
+    }
+
+    // Only touches the screen bytes below the caret
+    if (Timer.GetTicks() - caretToggled >= _KERNEL_CARET_INTERVAL) {
+      caretToggled = Timer.GetTicks();
+      KShell_BlinkCaret(&vgaConfig);
+    }
+
+    _EndFrame();
+
+    // Wait for the next interrupt (a key or the timer)
     __asm__ __volatile__("hlt");
   }
 }
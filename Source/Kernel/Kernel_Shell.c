@@ -31,16 +31,24 @@
 #include "../Modules/Include/Collection.h"
 #include "../Modules/Include/Heap.h"
 #include "../Modules/Include/String.h"
-#include "../Modules/Include/Collection.h"
+#include "../Modules/Include/Text.h"
 
 #include "Include/Keyboard.h"
 
 
 typedef struct {
   char Name[48];
-  char *Text;
-  char *Cursor;
-  U32 Size;
+  TextBuffer *Text;
+  // The first visible row of the layout
+  U32 TopLine;
+
+  // The text laid out into the rows of the text area. It is only rebuilt
+  // after edits (or if the width of the area changes).
+  TextRun *Runs;
+  U32 RunCount;
+  U32 RunCapacity;
+  U16 LayoutWidth;
+  bool LayoutValid;
 
   void (*OnKeyDown)(KeyEventArgs *eventArgs);
   void (*OnKeyUp)(KeyEventArgs *eventArgs);
@@ -99,23 +107,46 @@ static const KShellTheme _ThemeBright = {
 #define FONT_BOLD EnviousBold
 
 
+// The fonts are rendered at build time; the text font is baked with a
+// glyph cache, since buffer text is drawn at arbitrary offsets most of
+// the time (see GFXTK_BAKED_FONTS in the GfxTk Makefile)
+extern const Font BAKED_FONT(FONT_TOOLBAR);
+extern const Font BAKED_FONT(FONT_STATUSBAR);
+extern const Font BAKED_FONT(FONT_TAB);
+extern const Font BAKED_FONT(FONT_TEXT);
+extern const Font BAKED_FONT(FONT_ITALIC);
+extern const Font BAKED_FONT(FONT_BOLD);
+
+
 
 typedef struct {
   HeapArea *Heap;
   
-  Font ToolbarFont;
-  Font StatusbarFont;
-  Font TabFont;
+  const Font *ToolbarFont;
+  const Font *StatusbarFont;
+  const Font *TabFont;
 
-  Font TextFont;
-  Font ItalicFont;
-  Font BoldFont;
+  const Font *TextFont;
+  const Font *ItalicFont;
+  const Font *BoldFont;
   KShellTheme *Theme;
 
 
   List *Buffers;
   KShellBuffer *ActiveBuffer;
   KeyEventArgs KeyArgs;
+
+  // The inputs of the layout when it was last drawn
+  U32 ShownBytesFree;
+  KShellBuffer *ShownBuffer;
+  KeyCode ShownKeyCode;
+
+  // The frame timings shown on top of the toolbar (toggled with F12)
+  bool ShowFrameStats;
+  char FrameStats[96];
+
+  // The text cursor of the active buffer, XORed onto the screen
+  VgaOverlay Caret;
 } KShellState;
 
 
@@ -126,6 +157,7 @@ import(String);
 import(Collection);
 import(Heap);
 import(Keyboard);
+import(Text);
 
 static KShellState _State;
 
@@ -135,126 +167,275 @@ static KShellState _State;
 // Layout
 // ----------------------------------------------------------------------
 
+// The theme colors are consecutive, starting at COLOR_TEXT
+#define _KSHELL_THEME_COLOR_COUNT 8
+
+
+static const U8 _CaretMask[8] = { 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0 };
+
+static const VgaSprite _CaretSprite = {
+  .Size = { 2, sizeof(_CaretMask) },
+  .Mask = _CaretMask
+};
+
+
+// Switch to a theme with the next vertical retrace
 static inline void _SetColorTheme(const KShellTheme *theme) {
-  Vga.SetPalette(COLOR_TEXT, theme->Text);
-  Vga.UseColor(COLOR_TEXT, COLOR_TEXT);
-  
-  Vga.SetPalette(COLOR_ACCENT, theme->UiAccent);
-  Vga.UseColor(COLOR_ACCENT, COLOR_ACCENT);
-  
-  Vga.SetPalette(COLOR_ACCENT_ALT, theme->UiAccentAlt);
-  Vga.UseColor(COLOR_ACCENT_ALT, COLOR_ACCENT_ALT);
-  
-  Vga.SetPalette(COLOR_EDITOR_BG, theme->EditorBg);
-  Vga.UseColor(COLOR_EDITOR_BG, COLOR_EDITOR_BG);
+  const Rgb18 colors[_KSHELL_THEME_COLOR_COUNT] = {
+    [COLOR_TEXT] = theme->Text,
+    [COLOR_ACCENT] = theme->UiAccent,
+    [COLOR_ACCENT_ALT] = theme->UiAccentAlt,
+    [COLOR_EDITOR_BG] = theme->EditorBg,
+    [COLOR_PANEL] = theme->Panel,
+    [COLOR_TEXT_ALT] = theme->TextAlt,
+    [COLOR_TOOLBAR] = theme->Toolbar,
+    [COLOR_ACTIVE] = theme->Active
+  };
 
-  Vga.SetPalette(COLOR_PANEL, theme->Panel);
-  Vga.UseColor(COLOR_PANEL, COLOR_PANEL);
+  Vga.QueuePaletteRange(COLOR_TEXT, _KSHELL_THEME_COLOR_COUNT, colors);
+}
 
-  Vga.SetPalette(COLOR_TEXT_ALT, theme->TextAlt);
-  Vga.UseColor(COLOR_TEXT_ALT, COLOR_TEXT_ALT);
 
-  Vga.SetPalette(COLOR_TOOLBAR, theme->Toolbar);
-  Vga.UseColor(COLOR_TOOLBAR, COLOR_TOOLBAR);
+// Let every theme color show the palette color of the same index
+static inline void _UseThemeColors(void) {
+  static const U8 paletteIndices[_KSHELL_THEME_COLOR_COUNT] = {
+    COLOR_TEXT, COLOR_ACCENT, COLOR_ACCENT_ALT, COLOR_EDITOR_BG,
+    COLOR_PANEL, COLOR_TEXT_ALT, COLOR_TOOLBAR, COLOR_ACTIVE
+  };
 
-  Vga.SetPalette(COLOR_ACTIVE, theme->Active);
-  Vga.UseColor(COLOR_ACTIVE, COLOR_ACTIVE);
+  Vga.UseColorRange(COLOR_TEXT, _KSHELL_THEME_COLOR_COUNT, paletteIndices);
 }
 
 static void _SetupKeyHandlers(void);
 static void _KeyDebug(KeyEventArgs *eventArgs);
 
 
-static void _TextBuffer_HandleInput(KeyEventArgs *eventArgs) {
+// Move the cursor up or down, keeping its column if possible
+static void _TextBuffer_MoveLines(TextBuffer *text, I32 offset) {
+  U32 line = Text.GetLineOf(text, text->GapStart);
+  U32 lineCount = Text.GetLineCount(text);
+  U32 column = text->GapStart - Text.GetLineStart(text, line);
+
+  if (offset < 0)
+    line = (U32)-offset > line ? 0 : line + offset;
+  else
+    line = line + offset >= lineCount ? lineCount - 1 : line + offset;
+
+  U32 lineStart = Text.GetLineStart(text, line);
+  U32 lineEnd = line + 1 < lineCount
+    ? Text.GetLineStart(text, line + 1) - 1
+    : Text.GetLength(text);
+
+  if (column > lineEnd - lineStart)
+    column = lineEnd - lineStart;
+
+  Text.SetCursor(text, lineStart + column);
+}
+
+
+static bool _TextBuffer_HandleNavigation(TextBuffer *text, KeyCode keyCode) {
+  switch (keyCode) {
+  case KEY_UP:
+    _TextBuffer_MoveLines(text, -1);
+    return true;
+
+  case KEY_DOWN:
+    _TextBuffer_MoveLines(text, 1);
+    return true;
+
+  case KEY_LEFT:
+    Text.MoveCursor(text, -1);
+    return true;
+
+  case KEY_RIGHT:
+    Text.MoveCursor(text, 1);
+    return true;
+
+  case KEY_HOME:
+    Text.SetCursor(text, Text.GetLineStart(text, Text.GetLineOf(text, text->GapStart)));
+    return true;
+
+  case KEY_END: {
+    U32 line = Text.GetLineOf(text, text->GapStart);
+    U32 position = Text.GetLineStart(text, line + 1);
+
+    // Stop in front of the line break
+    if (Text.GetLineOf(text, position) > line)
+      position--;
+
+    Text.SetCursor(text, position);
+    return true;
+  }
+
+  case KEY_DELETE:
+    Text.DeleteForward(text, 1);
+    return true;
+  }
+
+  return false;
+}
+
+
+static void _TextBuffer_HandleKey(TextBuffer *text, KeyEventArgs *eventArgs) {
+  if (_TextBuffer_HandleNavigation(text, eventArgs->KeyCode)) {
+    eventArgs->Handled = true;
+    return;
+  }
+
   char glyph = Keyboard.GetChar(eventArgs->KeyCode, *eventArgs->Modifiers);
   if (!glyph)
     return;
 
-  if (_State.ActiveBuffer) {
-    switch (glyph) {
-    case '\b':
-      if (_State.ActiveBuffer->Cursor <= _State.ActiveBuffer->Text)
-	break;
-      
-      *(_State.ActiveBuffer->Cursor--) = 0;
-      *(_State.ActiveBuffer->Cursor) = 0;
-      break;
-      
-    default:
-      *(_State.ActiveBuffer->Cursor++) = glyph;
-      *_State.ActiveBuffer->Cursor = 0;
-      break;
-    }
+  switch (glyph) {
+  case '\b':
+    Text.DeleteBackward(text, 1);
+    break;
+
+  default:
+    Text.Insert(text, &glyph, 1);
+    break;
   }
 
   eventArgs->Handled = true;
 }
 
 
+static void _TextBuffer_HandleInput(KeyEventArgs *eventArgs) {
+  KShellBuffer *buffer = _State.ActiveBuffer;
+  if (!buffer)
+    return;
+
+  U32 length = Text.GetLength(buffer->Text);
+  _TextBuffer_HandleKey(buffer->Text, eventArgs);
+
+  // Every edit changes the length of the text
+  if (Text.GetLength(buffer->Text) != length)
+    buffer->LayoutValid = false;
+}
+
+
 #define _KSHELL_DEFAULTBUFFER_SIZE 1024
 
 static void _InitializeDefaultBuffer(void) {
   KShellBuffer *defaultBuffer = Heap.Allocate(_State.Heap, sizeof(KShellBuffer));
   *defaultBuffer = (KShellBuffer) {
     .Name = "MyBuffer",
-    .Text = Heap.Allocate(_State.Heap, _KSHELL_DEFAULTBUFFER_SIZE),
-    .Size = _KSHELL_DEFAULTBUFFER_SIZE,
+    .Text = Text.Create(_State.Heap, _KSHELL_DEFAULTBUFFER_SIZE),
     .OnKeyDown = &_TextBuffer_HandleInput
   };
 
-  defaultBuffer->Cursor = defaultBuffer->Text;
   Collection.List.Add(_State.Buffers, defaultBuffer);
   _State.ActiveBuffer = defaultBuffer;
 }
 
 void KShell_Initialize(VgaConfig *config, HeapArea *heap) {
-  Bitmap8x8* toolbarFontBitmap = Renderer.GetFontBitmap(FONT_TOOLBAR);
-  Renderer.RenderFont(&_State.ToolbarFont, toolbarFontBitmap, "Toolbar", false);
-
-  Bitmap8x8* statusbarFontBitmap = Renderer.GetFontBitmap(FONT_STATUSBAR);
-  Renderer.RenderFont(&_State.StatusbarFont, statusbarFontBitmap, "Statusbar", false);
-  
-  Bitmap8x8* tabFontBitmap = Renderer.GetFontBitmap(FONT_TAB);
-  Renderer.RenderFont(&_State.TabFont, tabFontBitmap, "Tab", false);
-
-  Bitmap8x8* textFontBitmap = Renderer.GetFontBitmap(FONT_TEXT);
-  Renderer.RenderFont(&_State.TextFont, textFontBitmap, "Text", false);
-
-  Bitmap8x8* italicFontBitmap = Renderer.GetFontBitmap(FONT_ITALIC);
-  Renderer.RenderFont(&_State.ItalicFont, italicFontBitmap, "TextItalic", false);
+  _State.ToolbarFont = &BAKED_FONT(FONT_TOOLBAR);
+  _State.StatusbarFont = &BAKED_FONT(FONT_STATUSBAR);
+  _State.TabFont = &BAKED_FONT(FONT_TAB);
 
-  Bitmap8x8* boldFontBitmap = Renderer.GetFontBitmap(FONT_BOLD);
-  Renderer.RenderFont(&_State.BoldFont, boldFontBitmap, "TextBold", false);
+  _State.TextFont = &BAKED_FONT(FONT_TEXT);
+  _State.ItalicFont = &BAKED_FONT(FONT_ITALIC);
+  _State.BoldFont = &BAKED_FONT(FONT_BOLD);
   
   
   _State.Theme = (KShellTheme*)&_ThemeBright;
   _State.Heap = heap;
+  _UseThemeColors();
   _SetColorTheme(_State.Theme);
 
+  // The caret swaps the text and the background color
+  _State.Caret = (VgaOverlay) {
+    .Sprite = &_CaretSprite,
+    .Color = COLOR_TEXT ^ COLOR_EDITOR_BG
+  };
+
   // Initialize buffers
   _State.Buffers = Collection.List.Create(_State.Heap);
   _InitializeDefaultBuffer();
   _SetupKeyHandlers();
+
+  // Placed by the first drawing of the text area
+  Renderer.ShowOverlay(config, &_State.Caret);
 }
 
 
 #define _KSHELL_ZERO ((Vector2d) { 0, 0 })
 
 
+// The parts of the layout that are drawn independently
+// Elements later in the list are drawn on top of earlier ones.
+typedef enum {
+  KShellBackground = 0,
+  KShellToolbar,
+  KShellStatusbar,
+  KShellContentFrame,
+  KShellTabHeader,
+  KShellTextArea,
+  KShellFrameStats,
+  KShellElementCount
+} KShellElementId;
+
+
+// A retained part of the layout
+// It stays in the backbuffer until one of its inputs changes; only then
+// it is drawn again (and uploaded by the next refresh).
+typedef struct {
+  bool Valid;
+  void (*Draw)(VgaConfig *config);
+} KShellElement;
+
+static void _DrawBackground(VgaConfig *config);
+static void _DrawToolbar(VgaConfig *config);
+static void _DrawStatusbar(VgaConfig *config);
+static void _DrawContentFrame(VgaConfig *config);
+static void _DrawTabHeader(VgaConfig *config);
+static void _DrawTextArea(VgaConfig *config);
+static void _DrawFrameStats(VgaConfig *config);
+
+static KShellElement _Elements[KShellElementCount] = {
+  [KShellBackground]   = { .Draw = _DrawBackground },
+  [KShellToolbar]      = { .Draw = _DrawToolbar },
+  [KShellStatusbar]    = { .Draw = _DrawStatusbar },
+  [KShellContentFrame] = { .Draw = _DrawContentFrame },
+  [KShellTabHeader]    = { .Draw = _DrawTabHeader },
+  [KShellTextArea]     = { .Draw = _DrawTextArea },
+  [KShellFrameStats]   = { .Draw = _DrawFrameStats }
+};
+
+
+static inline void _InvalidateElement(KShellElementId id) {
+  _Elements[id].Valid = false;
+}
+
+
+
+static void _DrawBackground(VgaConfig *config) {
+  Renderer.FillScreen(config, COLOR_ACCENT_ALT);
+
+  // Everything else has been painted over
+  for (U8 id = KShellBackground + 1; id < KShellElementCount; id++)
+    _InvalidateElement(id);
+}
+
+
 #define _KSHELL_TOOLBAR_HEIGHT 50
 
+char text[40];
 static void _DrawToolbar(VgaConfig *config) {
   Vector2d toolbarSize = { config->Resolution.X, _KSHELL_TOOLBAR_HEIGHT };
 
   Renderer.RenderFilledRect(config, _KSHELL_ZERO, toolbarSize, COLOR_TOOLBAR);
-  Renderer.RenderAsciiZ(config, (Vector2d) { 18, 3 }, "free86 debug session", &_State.ToolbarFont, COLOR_ACCENT);
-  Renderer.RenderAsciiZ(config, (Vector2d) { 18, 13 }, "GFXTK Renderer", &_State.ToolbarFont, COLOR_ACCENT);
+  Renderer.RenderAsciiZ(config, (Vector2d) { 18, 3 }, "free86 debug session", _State.ToolbarFont, COLOR_ACCENT);
+  Renderer.RenderAsciiZ(config, (Vector2d) { 18, 13 }, "GFXTK Renderer", _State.ToolbarFont, COLOR_ACCENT);
+  Renderer.RenderAsciiZ(config, (Vector2d) { 10, 30 }, text, _State.StatusbarFont, COLOR_TEXT);
+
+  // The frame timings are shown on top
+  _InvalidateElement(KShellFrameStats);
 }
 
 
 #define _KSHELL_STATUSBAR_HEIGHT 14
 
-char text[40];
 static void _DrawStatusbar(VgaConfig *config) {
   Vector2d statusbarSize = { config->Resolution.X, _KSHELL_STATUSBAR_HEIGHT };
   Vector2d statusbarStart = { 0, config->Resolution.Y - _KSHELL_STATUSBAR_HEIGHT};
@@ -264,9 +445,8 @@ static void _DrawStatusbar(VgaConfig *config) {
   
   char statusbarText[128] = { };
   U32 percentFree = (_State.Heap->TotalBytesFree * 100) / _State.Heap->TotalBytes;
-  String.Format(statusbarText, "%d of %d bytes free (%d%%)", _State.Heap->TotalBytesFree, _State.Heap->TotalBytes,  percentFree);
-  Renderer.RenderAsciiZ(config, statusbarTextStart, statusbarText, &_State.StatusbarFont, COLOR_TEXT_ALT);
-  Renderer.RenderAsciiZ(config, (Vector2d) { 10, 30 }, text, &_State.StatusbarFont, COLOR_TEXT);
+  String.FormatN(statusbarText, sizeof(statusbarText), "%u of %u bytes free (%u%%)", _State.Heap->TotalBytesFree, _State.Heap->TotalBytes,  percentFree);
+  Renderer.RenderAsciiZ(config, statusbarTextStart, statusbarText, _State.StatusbarFont, COLOR_TEXT_ALT);
 }
 
 
@@ -288,43 +468,279 @@ static void _DrawStatusbar(VgaConfig *config) {
 
 
 
-static void _DrawContentArea(VgaConfig *config) {
+// Holds the line that is passed to the renderer
+#define _KSHELL_LINE_SCRATCH_SIZE 256
+
+static char _LineScratch[_KSHELL_LINE_SCRATCH_SIZE];
+
+#define _KSHELL_INITIAL_RUN_CAPACITY 64
+
+
+// Make room for a number of runs in the layout of a buffer
+static bool _ReserveRuns(KShellBuffer *buffer, U32 count) {
+  if (count <= buffer->RunCapacity)
+    return true;
+
+  U32 capacity = buffer->RunCapacity ? buffer->RunCapacity : _KSHELL_INITIAL_RUN_CAPACITY;
+  while (capacity < count)
+    capacity <<= 1;
+
+  TextRun *runs = Heap.Allocate(_State.Heap, capacity * sizeof(TextRun));
+  if (!runs)
+    return false;
+
+  for (U32 index = 0; index < buffer->RunCount; index++)
+    runs[index] = buffer->Runs[index];
+  if (buffer->Runs)
+    Heap.Free(_State.Heap, buffer->Runs);
+
+  buffer->Runs = runs;
+  buffer->RunCapacity = capacity;
+  return true;
+}
+
+
+// Lay out the text of a buffer into rows of a certain width (unless the
+// layout is still valid)
+static void _UpdateLayout(KShellBuffer *buffer, U16 width) {
+  if (buffer->LayoutValid && buffer->LayoutWidth == width)
+    return;
+
+  TextBuffer *text = buffer->Text;
+  U32 length = Text.GetLength(text);
+  U32 position = 0;
+  buffer->RunCount = 0;
+
+  // The text is laid out in chunks that fit into the scratch
+  for (;;) {
+    U32 chunkLength = Text.CopyRange(text, position, _KSHELL_LINE_SCRATCH_SIZE - 1, _LineScratch);
+    bool lastChunk = position + chunkLength >= length;
+
+    // There is at most one run per char, plus one
+    if (!_ReserveRuns(buffer, buffer->RunCount + chunkLength + 1))
+      break;
+
+    TextRun *runs = buffer->Runs + buffer->RunCount;
+    U32 runCount = Renderer.LayoutText(_State.TextFont, _LineScratch, chunkLength, width, runs, chunkLength + 1);
+
+    // The last run of a chunk may go on in the next one
+    U32 next = position + chunkLength;
+    if (!lastChunk && runCount > 1)
+      next = position + runs[--runCount].Start;
+
+    for (U32 index = 0; index < runCount; index++)
+      runs[index].Start += position;
+
+    buffer->RunCount += runCount;
+    if (lastChunk)
+      break;
+
+    position = next;
+  }
+
+  buffer->LayoutWidth = width;
+  buffer->LayoutValid = true;
+}
+
+
+// Get the row of the layout that shows a text position
+static U32 _GetRowOf(KShellBuffer *buffer, U32 position) {
+  U32 low = 0;
+  U32 high = buffer->RunCount;
+
+  // Find the last run that starts in front of the position
+  while (low + 1 < high) {
+    U32 middle = (low + high) >> 1;
+
+    if (buffer->Runs[middle].Start <= position)
+      low = middle;
+    else
+      high = middle;
+  }
+
+  return low;
+}
+
+
+// Draw the rows of a buffer that fit into the text area
+static void _DrawBufferText(VgaConfig *config, KShellBuffer *buffer, Vector2d start, Vector2d size) {
+  TextBuffer *text = buffer->Text;
+  U16 lineHeight = sizeof(Bitmap8x8) + _State.TextFont->LineSpacing;
+  U32 visibleLines = size.Y / lineHeight;
+  if (!visibleLines)
+    return;
+
+  _UpdateLayout(buffer, size.X);
+
+  // Scroll the cursor into view
+  U32 cursorLine = _GetRowOf(buffer, text->GapStart);
+  if (cursorLine < buffer->TopLine)
+    buffer->TopLine = cursorLine;
+  else if (cursorLine >= buffer->TopLine + visibleLines)
+    buffer->TopLine = cursorLine - visibleLines + 1;
+
+  U32 lastLine = buffer->TopLine + visibleLines;
+  if (lastLine > buffer->RunCount)
+    lastLine = buffer->RunCount;
+
+  Renderer.PushClip(config, start, size);
+
+  for (U32 line = buffer->TopLine; line < lastLine; line++) {
+    TextRun *run = &buffer->Runs[line];
+    Text.CopyRange(text, run->Start, run->Length, _LineScratch);
+
+    Vector2d lineStartPos = { start.X, start.Y + (line - buffer->TopLine) * lineHeight };
+    Renderer.RenderAsciiZ(config, lineStartPos, _LineScratch, _State.TextFont, COLOR_TEXT);
+  }
+
+  Renderer.PopClip(config);
+
+  // Runs are missing if they could not be allocated
+  if (cursorLine >= buffer->RunCount)
+    return;
+
+  // Put the caret behind the text in front of the cursor
+  TextRun *cursorRun = &buffer->Runs[cursorLine];
+  U32 cursorColumn = text->GapStart - cursorRun->Start;
+  Text.CopyRange(text, cursorRun->Start, cursorColumn, _LineScratch);
+
+  Vector2d caretPosition = {
+    start.X + Renderer.MeasureText(_State.TextFont, _LineScratch, cursorColumn),
+    start.Y + (cursorLine - buffer->TopLine) * lineHeight
+  };
+  Renderer.MoveOverlay(config, &_State.Caret, caretPosition);
+}
+
+
+// Get the bounds of the content area (including its border)
+static inline void _GetContentArea(VgaConfig *config, Vector2d *areaStart, Vector2d *areaSize) {
   U16 areaStartY = _KSHELL_TOOLBAR_HEIGHT + _KSHELL_BORDER_TOP + _KSHELL_TABHEADER_HEIGHT;
   U16 borderTotal = _KSHELL_BORDER_LEFT + _KSHELL_BORDER_RIGHT;
   U16 areaEndY = config->Resolution.Y - _KSHELL_BORDER_BOTTOM - _KSHELL_STATUSBAR_HEIGHT;
   
-  Vector2d areaStart = { _KSHELL_BORDER_LEFT, areaStartY };
-  Vector2d areaSize = { config->Resolution.X - borderTotal, areaEndY - areaStartY };
+  *areaStart = (Vector2d) { _KSHELL_BORDER_LEFT, areaStartY };
+  *areaSize = (Vector2d) { config->Resolution.X - borderTotal, areaEndY - areaStartY };
+}
+
+static void _DrawContentFrame(VgaConfig *config) {
+  Vector2d areaStart, areaSize;
+  _GetContentArea(config, &areaStart, &areaSize);
 
-  // Editor background
-  Renderer.RenderFilledRect(config, areaStart, areaSize, COLOR_EDITOR_BG);
-  // Border
   Renderer.RenderRect(config, areaStart, areaSize, _KSHELL_BORDER_WIDTH, COLOR_PANEL);
-  // Header
+}
+
+static void _DrawTabHeader(VgaConfig *config) {
+  Vector2d areaStart, areaSize;
+  _GetContentArea(config, &areaStart, &areaSize);
+
   Renderer.RenderFilledRect(config, areaStart, (Vector2d) { areaSize.X, _KSHELL_TABHEADER_HEIGHT}, COLOR_PANEL);
-  
-  if (_State.ActiveBuffer) {
-    Vector2d headerTextStart = (Vector2d) {
-      areaStart.X + _KSHELL_BORDER_WIDTH,
-      areaStart.Y + _KSHELL_BORDER_WIDTH
-    };
-    
-    Renderer.RenderAsciiZ(config, headerTextStart, _State.ActiveBuffer->Name, &_State.TabFont, COLOR_TEXT);
-    Vector2d bodyTextStart = (Vector2d) {
-      areaStart.X + _KSHELL_BORDER_WIDTH + 30,
-      areaStart.Y + _KSHELL_BORDER_WIDTH + _KSHELL_TABHEADER_HEIGHT
-    };
+  if (!_State.ActiveBuffer)
+    return;
+
+  Vector2d headerTextStart = (Vector2d) {
+    areaStart.X + _KSHELL_BORDER_WIDTH,
+    areaStart.Y + _KSHELL_BORDER_WIDTH
+  };
     
-    Renderer.RenderAsciiZ(config, bodyTextStart, _State.ActiveBuffer->Text, &_State.TextFont, COLOR_TEXT);
+  Renderer.RenderAsciiZ(config, headerTextStart, _State.ActiveBuffer->Name, _State.TabFont, COLOR_TEXT);
+}
+
+// Get the bounds of the buffer text inside the content area
+static inline void _GetTextArea(VgaConfig *config, Vector2d *textStart, Vector2d *textSize) {
+  Vector2d areaStart, areaSize;
+  _GetContentArea(config, &areaStart, &areaSize);
+
+  *textStart = (Vector2d) {
+    areaStart.X + _KSHELL_BORDER_WIDTH + 30,
+    areaStart.Y + _KSHELL_BORDER_WIDTH + _KSHELL_TABHEADER_HEIGHT
+  };
+  *textSize = (Vector2d) {
+    areaStart.X + areaSize.X - _KSHELL_BORDER_WIDTH - textStart->X,
+    areaStart.Y + areaSize.Y - _KSHELL_BORDER_WIDTH - textStart->Y
+  };
+}
+
+static void _DrawTextArea(VgaConfig *config) {
+  Vector2d areaStart, areaSize;
+  _GetContentArea(config, &areaStart, &areaSize);
+
+  // Everything inside the border and below the header
+  Vector2d bodyStart = {
+    areaStart.X + _KSHELL_BORDER_WIDTH,
+    areaStart.Y + _KSHELL_TABHEADER_HEIGHT
+  };
+  Vector2d bodySize = {
+    areaSize.X - 2 * _KSHELL_BORDER_WIDTH,
+    areaSize.Y - _KSHELL_TABHEADER_HEIGHT - _KSHELL_BORDER_WIDTH
+  };
+
+  Renderer.RenderFilledRect(config, bodyStart, bodySize, COLOR_EDITOR_BG);
+  if (!_State.ActiveBuffer)
+    return;
+
+  Vector2d bodyTextStart, bodyTextSize;
+  _GetTextArea(config, &bodyTextStart, &bodyTextSize);
+  _DrawBufferText(config, _State.ActiveBuffer, bodyTextStart, bodyTextSize);
+}
+
+
+#define _KSHELL_FRAMESTATS_WIDTH 330
+
+#define _KSHELL_FRAMESTATS_HEIGHT 12
+
+static void _DrawFrameStats(VgaConfig *config) {
+  if (!_State.ShowFrameStats)
+    return;
+
+  Vector2d start = { config->Resolution.X - _KSHELL_FRAMESTATS_WIDTH, 30 };
+  Vector2d size = { _KSHELL_FRAMESTATS_WIDTH - 10, _KSHELL_FRAMESTATS_HEIGHT };
+
+  Renderer.RenderFilledRect(config, start, size, COLOR_TOOLBAR);
+  Renderer.RenderAsciiZ(config, (Vector2d) { start.X + 2, start.Y + 2 }, _State.FrameStats, _State.StatusbarFont, COLOR_TEXT);
+}
+
+
+// Invalidate the elements whose inputs changed since they were drawn
+static void _CheckLayoutInputs(void) {
+  if (_State.Heap->TotalBytesFree != _State.ShownBytesFree) {
+    _State.ShownBytesFree = _State.Heap->TotalBytesFree;
+    _InvalidateElement(KShellStatusbar);
+  }
+
+  if (_State.ActiveBuffer != _State.ShownBuffer) {
+    _State.ShownBuffer = _State.ActiveBuffer;
+    _InvalidateElement(KShellTabHeader);
+    _InvalidateElement(KShellTextArea);
+  }
+}
+
+// Bring the layout up to date with its inputs
+// Returns whether anything has to be drawn.
+bool KShell_UpdateLayout(VgaConfig *config) {
+  _CheckLayoutInputs();
+
+  if (!_Elements[KShellTextArea].Valid && _State.ActiveBuffer) {
+    Vector2d textStart, textSize;
+    _GetTextArea(config, &textStart, &textSize);
+    _UpdateLayout(_State.ActiveBuffer, textSize.X);
   }
+
+  for (U8 id = 0; id < KShellElementCount; id++)
+    if (!_Elements[id].Valid)
+      return true;
+
+  return false;
 }
 
+// Draw the elements that changed since they were drawn last
 void KShell_DrawLayout(VgaConfig *config) {
-  Renderer.FillScreen(config, COLOR_ACCENT_ALT);
-  _DrawToolbar(config);
-  _DrawStatusbar(config);
+  for (U8 id = 0; id < KShellElementCount; id++) {
+    if (_Elements[id].Valid)
+      continue;
 
-  _DrawContentArea(config);
+    _Elements[id].Draw(config);
+    _Elements[id].Valid = true;
+  }
 }
 
 
@@ -358,15 +774,58 @@ void KShell_NotifyKeyPress(KeyEventArgs eventArgs) {
       _State.ActiveBuffer->OnKeyDown(&_State.KeyArgs);
     else if (_State.ActiveBuffer->OnKeyUp)
       _State.ActiveBuffer->OnKeyUp(&_State.KeyArgs);
+
+    if (_State.KeyArgs.Handled)
+      _InvalidateElement(KShellTextArea);
   }
 }
 
 
+// Show or hide the caret
+void KShell_BlinkCaret(VgaConfig *config) {
+  if (_State.Caret.Visible)
+    Renderer.HideOverlay(config, &_State.Caret);
+  else
+    Renderer.ShowOverlay(config, &_State.Caret);
+}
+
+
+// Set the frame timings to show (see _ToggleFrameStats)
+void KShell_SetFrameStats(const char *text) {
+  String.CopyN(_State.FrameStats, (string)text, sizeof(_State.FrameStats));
+
+  if (_State.ShowFrameStats)
+    _InvalidateElement(KShellFrameStats);
+}
+
+
+static void _ToggleFrameStats(KeyEventArgs *eventArgs) {
+  if (eventArgs->KeyCode != KEY_F12)
+    return;
+
+  eventArgs->Handled = true;
+  if (eventArgs->WasKeyPress)
+    return;
+
+  _State.ShowFrameStats = !_State.ShowFrameStats;
+
+  // The toolbar is below the timings and covers them when they are hidden
+  _InvalidateElement(_State.ShowFrameStats ? KShellFrameStats : KShellToolbar);
+}
+
+
 static void _KeyDebug(KeyEventArgs *eventArgs) {
-  String.Format(text, "KeyCode: %d", eventArgs->KeyCode);
+  // Releases and repeats do not change the code that is shown
+  if (eventArgs->WasKeyPress || eventArgs->KeyCode == _State.ShownKeyCode)
+    return;
+
+  _State.ShownKeyCode = eventArgs->KeyCode;
+  String.FormatN(text, sizeof(text), "KeyCode: %u", eventArgs->KeyCode);
+  _InvalidateElement(KShellToolbar);
 }
 
 static void _SetupKeyHandlers(void) {
   _GlobalKeyHandlers = Collection.List.Create(_State.Heap);
+  Collection.List.Add(_GlobalKeyHandlers, _ToggleFrameStats);
   Collection.List.Add(_GlobalKeyHandlers, _KeyDebug);
 }
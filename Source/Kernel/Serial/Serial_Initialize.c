@@ -0,0 +1,68 @@
+/*
+	
+  Copyright © 2025 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+
+#include "../Include/Serial.h"
+#include "../Include/HardwareIO.h"
+
+
+// The UART clock divided by 16
+#define _SERIAL_MAX_BAUD_RATE 115200
+
+#define _SERIAL_TEST_BYTE 0xae
+
+
+bool _Serial_InitializeImplementation(U16 port, U32 baudRate) {
+  U32 divisor = baudRate ? _SERIAL_MAX_BAUD_RATE / baudRate : 0;
+  if (!divisor || divisor > 0xffff)
+    return false;
+
+  // No interrupts, the port is polled
+  PortWriteByte(port + SERIAL_INTERRUPT_ENABLE, 0x00);
+
+  // Set the divisor latch access bit to program the baud rate
+  PortWriteByte(port + SERIAL_LINE_CONTROL, 0x80);
+  PortWriteByte(port + SERIAL_DIVISOR_LOW, divisor & 0xff);
+  PortWriteByte(port + SERIAL_DIVISOR_HIGH, (divisor >> 8) & 0xff);
+
+  // 8 data bits, no parity, one stop bit
+  PortWriteByte(port + SERIAL_LINE_CONTROL, 0x03);
+  // Enable and clear the FIFOs (ignored by UARTs without them)
+  PortWriteByte(port + SERIAL_FIFO_CONTROL, 0xc7);
+
+  // Send a byte to ourselves in loopback mode
+  PortWriteByte(port + SERIAL_MODEM_CONTROL, 0x1e);
+  PortWriteByte(port + SERIAL_DATA, _SERIAL_TEST_BYTE);
+  if (PortReadByte(port + SERIAL_DATA) != _SERIAL_TEST_BYTE)
+    return false;
+
+  // Back to normal operation with DTR, RTS and OUT2 set
+  PortWriteByte(port + SERIAL_MODEM_CONTROL, 0x0f);
+  return true;
+}
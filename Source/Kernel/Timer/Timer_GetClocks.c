@@ -0,0 +1,72 @@
+/*
+	
+  Copyright © 2025 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+
+#include "../Include/Timer.h"
+#include "../Include/Interrupt.h"
+
+
+// Channel 0, latch the current count
+#define _TIMER_COMMAND_LATCH 0x00
+
+// Makes the PIC return the pending interrupts on the next read
+#define _PIC_READ_IRR 0x0a
+
+
+// Incremented by the timer interrupt service routine
+extern volatile U32 _Timer_Ticks;
+
+// The PIT clocks per tick (see Timer_Initialize.c)
+extern U16 _Timer_Divisor;
+
+
+U32 _Timer_GetClocksImplementation(void) {
+  U32 divisor = _Timer_Divisor ? _Timer_Divisor : 0x10000;
+
+  DisableInterrupts();
+  PortWriteByte(TIMER_PORT_COMMAND, _TIMER_COMMAND_LATCH);
+  U8 low = PortReadByte(TIMER_PORT_CHANNEL0);
+  U8 high = PortReadByte(TIMER_PORT_CHANNEL0);
+  U32 ticks = _Timer_Ticks;
+
+  PortWriteByte(PIC1_COMMAND, _PIC_READ_IRR);
+  bool tickPending = PortReadByte(PIC1_COMMAND) & 0x01;
+  EnableInterrupts();
+
+  // The counter runs down from the divisor
+  U32 count = (high << 8) | low;
+  U32 elapsed = divisor - (count ? count : divisor);
+
+  // The counter has just restarted, but the interrupt for it has not
+  // been serviced yet
+  if (tickPending && elapsed < divisor / 2)
+    ticks++;
+
+  return (ticks * divisor) + elapsed;
+}
@@ -0,0 +1,59 @@
+/*
+	
+  Copyright © 2025 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+
+#include "../Include/Timer.h"
+#include "../Include/HardwareIO.h"
+
+
+// Channel 0, low and high byte, rate generator
+#define _TIMER_COMMAND_RATE_GENERATOR 0x34
+
+
+// Incremented by the timer interrupt service routine
+extern volatile U32 _Timer_Ticks;
+
+// The PIT clocks per tick (0 stands for 65536)
+U16 _Timer_Divisor;
+
+
+void _Timer_InitializeImplementation(U32 frequency) {
+  U32 divisor = TIMER_CLOCK_FREQUENCY / frequency;
+  if (divisor > 0xffff)
+    divisor = 0;
+
+  DisableInterrupts();
+  PortWriteByte(TIMER_PORT_COMMAND, _TIMER_COMMAND_RATE_GENERATOR);
+  PortWriteByte(TIMER_PORT_CHANNEL0, divisor & 0xff);
+  PortWriteByte(TIMER_PORT_CHANNEL0, (divisor >> 8) & 0xff);
+
+  _Timer_Divisor = divisor;
+  _Timer_Ticks = 0;
+  EnableInterrupts();
+}
@@ -45,8 +45,13 @@ build-bootloader: clean-bootloader $(BOOTLOADER_BINARY_FILE)
 
 
 # Build the bootloader binary
+# Sectors of the kernel the bootloader loads (up to 0x11000, which
+# leaves room for the BSS below the heap at 0x20000)
+KERNEL_LOAD_SECTORS = 128
+
+
 $(BOOTLOADER_BINARY_FILE): $(BOOTLOADER_SOURCE_FILE) $(BOOTLOADER_LINKER_FILE) | $(BOOTLOADER_BUILD_PATH)
-	$(AS) -o $(BOOTLOADER_OBJECT_FILE) -c $(BOOTLOADER_SOURCE_FILE)
+	$(AS) -o $(BOOTLOADER_OBJECT_FILE) --defsym KernelSectorCount=$(KERNEL_LOAD_SECTORS) -c $(BOOTLOADER_SOURCE_FILE)
 	$(LD) -o $(BOOTLOADER_BINARY_FILE) --oformat binary -T $(BOOTLOADER_LINKER_FILE) $(BOOTLOADER_OBJECT_FILE)
 
 
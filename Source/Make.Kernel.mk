@@ -28,6 +28,8 @@ KERNEL_BUILD_PATH = Kernel/Build
 KINTERRUPT_BUILD_PATH = Kernel/Build/Interrupt
 EQUIPMENT_BUILD_PATH = Kernel/Build/Equipment
 KEYBOARD_DRV_BUILD_PATH = Kernel/Build/Keyboard
+TIMER_DRV_BUILD_PATH = Kernel/Build/Timer
+SERIAL_DRV_BUILD_PATH = Kernel/Build/Serial
 SHELL_BUILD_PATH = Kernel/Build/Shell
 
 # Kernel sources directory
@@ -35,6 +37,8 @@ KERNEL_SOURCES_PATH = Kernel
 KINTERRUPT_SOURCES_PATH = $(KERNEL_SOURCES_PATH)/Interrupt
 EQUIPMENT_SOURCES_PATH = $(KERNEL_SOURCES_PATH)/Equipment
 KEYBOARD_DRV_SOURCES_PATH = $(KERNEL_SOURCES_PATH)/Keyboard
+TIMER_DRV_SOURCES_PATH = $(KERNEL_SOURCES_PATH)/Timer
+SERIAL_DRV_SOURCES_PATH = $(KERNEL_SOURCES_PATH)/Serial
 SHELL_SOURCES_PATH = $(KERNEL_SOURCES_PATH)/Shell
 
 # Kernel linker file
@@ -62,6 +66,10 @@ SHELL_C_SOURCES = \
 
 KEYBOARD_DRV_C_SOURCES = \
 	$(wildcard $(KEYBOARD_DRV_SOURCES_PATH)/*.c)
+TIMER_DRV_C_SOURCES = \
+	$(wildcard $(TIMER_DRV_SOURCES_PATH)/*.c)
+SERIAL_DRV_C_SOURCES = \
+	$(wildcard $(SERIAL_DRV_SOURCES_PATH)/*.c)
 
 # Kernel object files
 KERNEL_OBJECTS = \
@@ -72,6 +80,8 @@ KERNEL_OBJECTS = \
 	$(EQUIPMENT_C_SOURCES:$(EQUIPMENT_SOURCES_PATH)/%.c=$(EQUIPMENT_BUILD_PATH)/%.o) \
 	$(SHELL_C_SOURCES:$(SHELL_SOURCES_PATH)/%.c=$(SHELL_BUILD_PATH)/%.o) \
 	$(KEYBOARD_DRV_C_SOURCES:$(KEYBOARD_DRV_SOURCES_PATH)/%.c=$(KEYBOARD_DRV_BUILD_PATH)/%.o) \
+	$(TIMER_DRV_C_SOURCES:$(TIMER_DRV_SOURCES_PATH)/%.c=$(TIMER_DRV_BUILD_PATH)/%.o) \
+	$(SERIAL_DRV_C_SOURCES:$(SERIAL_DRV_SOURCES_PATH)/%.c=$(SERIAL_DRV_BUILD_PATH)/%.o) \
 	$(MOD_BITMAP_OUTPUT) \
 	$(MOD_MEMORY_OUTPUT) \
 	$(MOD_HEAP_OUTPUT) \
@@ -79,6 +89,7 @@ KERNEL_OBJECTS = \
 	$(MOD_STREAM_OUTPUT) \
 	$(MOD_COLLECTION_OUTPUT) \
 	$(MOD_HASH_OUTPUT) \
+	$(MOD_TEXT_OUTPUT) \
 	$(MOD_SHELL_OUTPUT) \
 	Modules/GfxTk/Build/GfxTk.o
 
@@ -96,6 +107,11 @@ clean-kernel:
 
 $(KERNEL_BINARY_FILE): $(KERNEL_OBJECTS) $(KERNEL_LIBS)| $(KERNEL_BUILD_PATH)
 	$(LD) -o $(KERNEL_BINARY_FILE) --oformat binary -T $(KERNEL_LINKER_FILE) $(KERNEL_OBJECTS)
+	@if [ $$(stat -c %s $(KERNEL_BINARY_FILE)) -gt $$(($(KERNEL_LOAD_SECTORS) * 512)) ]; then \
+		echo "$(KERNEL_BINARY_FILE) exceeds the $(KERNEL_LOAD_SECTORS) sectors the bootloader loads"; \
+		rm -f $(KERNEL_BINARY_FILE); \
+		exit 1; \
+	fi
 
 $(KERNEL_BUILD_PATH)/%.o: $(KERNEL_SOURCES_PATH)/%.s | $(KERNEL_BUILD_PATH)
 	$(AS) -o $@ $<
@@ -126,6 +142,20 @@ $(KEYBOARD_DRV_BUILD_PATH):
 	mkdir -p $(KEYBOARD_DRV_BUILD_PATH)
 
 
+$(TIMER_DRV_BUILD_PATH)/%.o: $(TIMER_DRV_SOURCES_PATH)/%.c | $(TIMER_DRV_BUILD_PATH)
+	$(CC) -o $@ $(CFLAGS) -c $<
+
+$(TIMER_DRV_BUILD_PATH):
+	mkdir -p $(TIMER_DRV_BUILD_PATH)
+
+
+$(SERIAL_DRV_BUILD_PATH)/%.o: $(SERIAL_DRV_SOURCES_PATH)/%.c | $(SERIAL_DRV_BUILD_PATH)
+	$(CC) -o $@ $(CFLAGS) -c $<
+
+$(SERIAL_DRV_BUILD_PATH):
+	mkdir -p $(SERIAL_DRV_BUILD_PATH)
+
+
 $(EQUIPMENT_BUILD_PATH)/%.o: $(EQUIPMENT_SOURCES_PATH)/%.c | $(EQUIPMENT_BUILD_PATH)
 	$(CC) -o $@ $(CFLAGS) -c $<
 
@@ -333,3 +333,41 @@ mod-hash: $(MOD_HASH_OUTPUT)
 
 clean-mod-hash:
 	rm -fr $(MOD_HASH_BUILD_PATH)
+
+
+
+# TEXT module
+MOD_TEXT_SOURCE_PATH = $(MODULES_BASE_PATH)/Text
+MOD_TEXT_BUILD_PATH = $(MODULES_BUILD_PATH)/Text
+MOD_TEXT_OUTPUT = $(MOD_TEXT_BUILD_PATH)/ModText.o
+
+MOD_TEXT_ASM = $(wildcard $(MOD_TEXT_SOURCE_PATH)/*.s)
+MOD_TEXT_C = $(wildcard $(MOD_TEXT_SOURCE_PATH)/*.c)
+MOD_TEXT_SOURCE = $(MOD_TEXT_ASM) $(MOD_TEXT_C)
+
+MOD_TEXT_OBJECTS = $(patsubst $(MOD_TEXT_SOURCE_PATH)/%.c, \
+                                 $(MOD_TEXT_BUILD_PATH)/%.o, \
+                                 $(MOD_TEXT_C)) \
+                     $(patsubst $(MOD_TEXT_SOURCE_PATH)/%.s, \
+                                 $(MOD_TEXT_BUILD_PATH)/%.o, \
+                                 $(MOD_TEXT_ASM))
+
+$(MOD_TEXT_BUILD_PATH):
+	mkdir -p $(MOD_TEXT_BUILD_PATH)
+
+$(MOD_TEXT_BUILD_PATH)/%.o: $(MOD_TEXT_SOURCE_PATH)/%.s | $(MOD_TEXT_BUILD_PATH)
+	$(AS) -o $@ $<
+
+$(MOD_TEXT_BUILD_PATH)/%.o: $(MOD_TEXT_SOURCE_PATH)/%.c | $(MOD_TEXT_BUILD_PATH)
+	$(CC) -o $@ $(CFLAGS) -c $<
+
+$(MOD_TEXT_OUTPUT): $(MOD_TEXT_OBJECTS)
+	$(LD) -r -o $@ $^
+
+
+.PHONY: mod-text clean-mod-text
+
+mod-text: $(MOD_TEXT_OUTPUT)
+
+clean-mod-text:
+	rm -fr $(MOD_TEXT_BUILD_PATH)
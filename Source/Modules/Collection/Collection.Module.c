@@ -42,6 +42,14 @@ extern bool	_GenericList_AnyImplementation(List* this, bool (*test)(void*));
 extern bool	_GenericList_AllImplementation(List* this, bool (*test)(void*));
 extern void*    _GenericList_FirstImplementation(List* this, bool (*test)(void*));
 
+extern PriorityQueue*	_GenericPriorityQueue_CreateImplementation(HeapArea* heap, U32 capacity);
+extern void		_GenericPriorityQueue_DisposeImplementation(PriorityQueue* this);
+extern QueueHandle	_GenericPriorityQueue_PushImplementation(PriorityQueue* this, U32 key, void* payload);
+extern void*		_GenericPriorityQueue_PopMinImplementation(PriorityQueue* this, U32* key);
+extern void*		_GenericPriorityQueue_PeekMinImplementation(PriorityQueue* this, U32* key);
+extern bool		_GenericPriorityQueue_DecreaseKeyImplementation(PriorityQueue* this, QueueHandle handle, U32 key);
+extern bool		_GenericPriorityQueue_RemoveImplementation(PriorityQueue* this, QueueHandle handle);
+
 
 members(GenericList) {
     .Create   = _GenericList_CreateImplementation,
@@ -57,7 +65,19 @@ members(GenericList) {
 };
 
 
+members(GenericPriorityQueue) {
+    .Create      = _GenericPriorityQueue_CreateImplementation,
+    .Dispose     = _GenericPriorityQueue_DisposeImplementation,
+    .Push        = _GenericPriorityQueue_PushImplementation,
+    .PopMin      = _GenericPriorityQueue_PopMinImplementation,
+    .PeekMin     = _GenericPriorityQueue_PeekMinImplementation,
+    .DecreaseKey = _GenericPriorityQueue_DecreaseKeyImplementation,
+    .Remove      = _GenericPriorityQueue_RemoveImplementation
+};
+
+
 
 members(Collection) {
-    .List = GenericList
+    .List = GenericList,
+    .PriorityQueue = GenericPriorityQueue
 };
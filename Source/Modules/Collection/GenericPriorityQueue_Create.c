@@ -0,0 +1,74 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "../Include/Collection.h"
+
+use(Heap);
+
+
+PriorityQueue* _GenericPriorityQueue_CreateImplementation(HeapArea* heap, U32 capacity) {
+  if (!heap || !capacity)
+    return null;
+
+  // Reject capacities the allocation size cannot hold (handles must
+  // also stay below QUEUE_INVALID_HANDLE, which this implies)
+  if (capacity > (0xffffffff - sizeof(PriorityQueue)) / (sizeof(QueueEntry) + sizeof(QueueHandle)))
+    return null;
+
+  // Queue header, entries and heap order share a single allocation
+  U32 totalSize = sizeof(PriorityQueue)
+    + capacity * sizeof(QueueEntry)
+    + capacity * sizeof(QueueHandle);
+
+  PriorityQueue* queue = Heap.Allocate(heap, totalSize);
+  if (!queue)
+    return null;
+
+  QueueEntry* entries = (QueueEntry*)(queue + 1);
+
+  *queue = (PriorityQueue) {
+    .Heap = heap,
+    .Entries = entries,
+    .Order = (QueueHandle*)(entries + capacity),
+    .Capacity = capacity,
+    .Count = 0,
+    .NextFree = 0
+  };
+
+  // Chain all entries into the free list
+  for (U32 index = 0; index < capacity; index++) {
+    entries[index] = (QueueEntry) {
+      .Key = 0,
+      .Payload = null,
+      .Position = index + 1 < capacity ? index + 1 : QUEUE_INVALID_HANDLE
+    };
+  }
+
+  return queue;
+}
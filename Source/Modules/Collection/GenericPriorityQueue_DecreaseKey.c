@@ -0,0 +1,48 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "../Include/Collection.h"
+
+extern bool _PriorityQueue_IsQueued(PriorityQueue* this, QueueHandle handle);
+extern void _PriorityQueue_SiftUp(PriorityQueue* this, U32 position);
+
+
+bool _GenericPriorityQueue_DecreaseKeyImplementation(PriorityQueue* this, QueueHandle handle, U32 key) {
+  if (!this || !_PriorityQueue_IsQueued(this, handle))
+    return false;
+
+  QueueEntry* entry = &this->Entries[handle];
+  if (key > entry->Key)
+    return false;
+
+  entry->Key = key;
+  _PriorityQueue_SiftUp(this, entry->Position);
+
+  return true;
+}
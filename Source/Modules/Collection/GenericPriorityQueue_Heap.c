@@ -0,0 +1,116 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "../Include/Collection.h"
+
+
+// Binary min-heap helpers shared by the priority queue functions
+
+
+void _PriorityQueue_Place(PriorityQueue* this, U32 position, QueueHandle handle) {
+  this->Order[position] = handle;
+  this->Entries[handle].Position = position;
+}
+
+
+void _PriorityQueue_SiftUp(PriorityQueue* this, U32 position) {
+  QueueHandle handle = this->Order[position];
+  U32 key = this->Entries[handle].Key;
+
+  while (position) {
+    U32 parent = (position - 1) >> 1;
+    QueueHandle parentHandle = this->Order[parent];
+
+    if (this->Entries[parentHandle].Key <= key)
+      break;
+
+    _PriorityQueue_Place(this, position, parentHandle);
+    position = parent;
+  }
+
+  _PriorityQueue_Place(this, position, handle);
+}
+
+
+static void _PriorityQueue_SiftDown(PriorityQueue* this, U32 position) {
+  QueueHandle handle = this->Order[position];
+  U32 key = this->Entries[handle].Key;
+
+  for (;;) {
+    U32 child = (position << 1) + 1;
+    if (child >= this->Count)
+      break;
+
+    // Pick the smaller of both children
+    if (child + 1 < this->Count
+	&& this->Entries[this->Order[child + 1]].Key < this->Entries[this->Order[child]].Key)
+      child++;
+
+    QueueHandle childHandle = this->Order[child];
+    if (key <= this->Entries[childHandle].Key)
+      break;
+
+    _PriorityQueue_Place(this, position, childHandle);
+    position = child;
+  }
+
+  _PriorityQueue_Place(this, position, handle);
+}
+
+
+bool _PriorityQueue_IsQueued(PriorityQueue* this, QueueHandle handle) {
+  if (handle >= this->Capacity)
+    return false;
+
+  U32 position = this->Entries[handle].Position;
+
+  return position < this->Count && this->Order[position] == handle;
+}
+
+
+// Unlink the entry at a heap position and recycle its handle
+void _PriorityQueue_RemoveAt(PriorityQueue* this, U32 position) {
+  QueueHandle handle = this->Order[position];
+  U32 removedKey = this->Entries[handle].Key;
+
+  this->Count--;
+  if (position < this->Count) {
+    QueueHandle last = this->Order[this->Count];
+    _PriorityQueue_Place(this, position, last);
+
+    if (this->Entries[last].Key < removedKey)
+      _PriorityQueue_SiftUp(this, position);
+    else
+      _PriorityQueue_SiftDown(this, position);
+  }
+
+  this->Entries[handle].Payload = null;
+  this->Entries[handle].Position = this->NextFree;
+  this->NextFree = handle;
+}
@@ -0,0 +1,52 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "../Include/Collection.h"
+
+extern void _PriorityQueue_Place(PriorityQueue* this, U32 position, QueueHandle handle);
+extern void _PriorityQueue_SiftUp(PriorityQueue* this, U32 position);
+
+
+QueueHandle _GenericPriorityQueue_PushImplementation(PriorityQueue* this, U32 key, void* payload) {
+  if (!this || this->NextFree == QUEUE_INVALID_HANDLE)
+    return QUEUE_INVALID_HANDLE;
+
+  QueueHandle handle = this->NextFree;
+  QueueEntry* entry = &this->Entries[handle];
+  this->NextFree = entry->Position;
+
+  entry->Key = key;
+  entry->Payload = payload;
+
+  U32 position = this->Count++;
+  _PriorityQueue_Place(this, position, handle);
+  _PriorityQueue_SiftUp(this, position);
+
+  return handle;
+}
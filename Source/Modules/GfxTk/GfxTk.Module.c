@@ -50,22 +50,79 @@ extern void _GfxTk_RenderRect(VgaConfig *config,
 
 extern U16 _GfxTk_RenderChar(VgaConfig *config,
 			      Vector2d position,
-			      RenderChar *glyph,
+			      const RenderChar *glyph,
 			      U8 color);
 
-extern RenderChar* _GfxTk_GetGlyph(Font *font, char asciiChar);
+extern const RenderChar* _GfxTk_GetGlyph(const Font *font, char asciiChar);
 
 extern void _GfxTk_RenderAsciiZ(VgaConfig *config,
 				Vector2d position,
 				char *text,
-				Font *font,
+				const Font *font,
 				U8 color);
 
+extern U16 _GfxTk_MeasureText(const Font *font,
+			      const char *text,
+			      U32 length);
+
+extern U32 _GfxTk_LayoutText(const Font *font,
+			     const char *text,
+			     U32 length,
+			     U16 width,
+			     TextRun *runs,
+			     U32 maxRuns);
+
+extern U32 _GfxTk_PackFont(const Font *source,
+			   void *image,
+			   U32 capacity);
+
+extern bool _GfxTk_LoadPackedFont(PackedFont *font,
+				  const void *image,
+				  U32 size);
+
+extern void _GfxTk_RenderPackedAsciiZ(VgaConfig *config,
+				      Vector2d position,
+				      char *text,
+				      const PackedFont *font,
+				      U8 color);
+
+extern void _GfxTk_Blit(VgaConfig *config,
+			Surface *surface,
+			Rect2d source,
+			Vector2d destination);
+
 extern void _GfxTk_FillScreen(VgaConfig *config, U8 color);
 
+extern bool _GfxTk_PushClip(VgaConfig *config,
+			    Vector2d position,
+			    Vector2d size);
+
+extern void _GfxTk_PopClip(VgaConfig *config);
+
+extern void _GfxTk_Invalidate(VgaConfig *config,
+			       Vector2d position,
+			       Vector2d size);
+
+extern Rect2d _GfxTk_ScrollRegion(VgaConfig *config,
+				  Vector2d position,
+				  Vector2d size,
+				  I16 rows);
+
 extern void _GfxTk_Refresh(VgaConfig *config);
 
-extern Bitmap8x8* _GfxTk_GetFontBitmap(FontId fontId);
+extern bool _GfxTk_ShowOverlay(VgaConfig *config, VgaOverlay *overlay);
+
+extern void _GfxTk_HideOverlay(VgaConfig *config, VgaOverlay *overlay);
+
+extern void _GfxTk_MoveOverlay(VgaConfig *config,
+			       VgaOverlay *overlay,
+			       Vector2d position);
+
+extern void _GfxTk_ChunkyToPlanar(VgaConfig *config,
+				  Rect2d region,
+				  U8 *planes);
+
+extern void _GfxTk_EnableGlyphCache(Font *font, GlyphCache *cache);
 
 
 members(Renderer) {
@@ -76,9 +133,23 @@ members(Renderer) {
     .RenderChar = _GfxTk_RenderChar,
     .GetGlyph = _GfxTk_GetGlyph,
     .RenderAsciiZ = _GfxTk_RenderAsciiZ,
+    .MeasureText = _GfxTk_MeasureText,
+    .LayoutText = _GfxTk_LayoutText,
+    .PackFont = _GfxTk_PackFont,
+    .LoadPackedFont = _GfxTk_LoadPackedFont,
+    .RenderPackedAsciiZ = _GfxTk_RenderPackedAsciiZ,
+    .Blit = _GfxTk_Blit,
     .FillScreen = _GfxTk_FillScreen,
+    .PushClip = _GfxTk_PushClip,
+    .PopClip = _GfxTk_PopClip,
+    .Invalidate = _GfxTk_Invalidate,
+    .ScrollRegion = _GfxTk_ScrollRegion,
     .Refresh = _GfxTk_Refresh,
-    .GetFontBitmap = _GfxTk_GetFontBitmap
+    .ShowOverlay = _GfxTk_ShowOverlay,
+    .HideOverlay = _GfxTk_HideOverlay,
+    .MoveOverlay = _GfxTk_MoveOverlay,
+    .ChunkyToPlanar = _GfxTk_ChunkyToPlanar,
+    .EnableGlyphCache = _GfxTk_EnableGlyphCache
 };
 
 
@@ -87,6 +158,10 @@ extern void _GfxTk_EnableOutput(void);
 
 extern void _GfxTk_DisableOutput(void);
 
+extern bool _GfxTk_SetMode(VgaConfig *config, VgaMode mode);
+
+extern U32 _GfxTk_GetPageSize(VgaConfig *config);
+
 extern void _GfxTk_SetBitmask(U8 bitmask);
 
 extern void _GfxTk_SetPlaneMask(U8 planeMask);
@@ -97,13 +172,69 @@ extern void _GfxTk_SetPalette(U8 index, Rgb18 color);
 
 extern void _GfxTk_UseColor(U8 index, U8 paletteIndex);
 
+extern void _GfxTk_SetPaletteRange(U8 start, U16 count, const Rgb18 *colors);
+
+extern void _GfxTk_QueuePaletteRange(U8 start, U16 count, const Rgb18 *colors);
+extern bool _GfxTk_HasQueuedPalette(void);
+
+extern void _GfxTk_UseColorRange(U8 index, U8 count, const U8 *paletteIndices);
+
+extern void _GfxTk_SetWriteMode(U8 mode);
+
+extern void _GfxTk_SetSetReset(U8 color);
+
+extern void _GfxTk_EnableSetReset(U8 planeMask);
+
+extern void _GfxTk_SetLogicOperation(VgaLogicOperation operation);
+
+extern void _GfxTk_SetStartAddress(U16 offset);
+
+extern void _GfxTk_SetLineCompare(U16 line);
+
+extern bool _GfxTk_EnablePageFlipping(VgaConfig *config);
+
+extern void _GfxTk_DisablePageFlipping(VgaConfig *config);
+
+extern void _GfxTk_FillScreenRect(VgaConfig *config,
+				  Vector2d position,
+				  Vector2d size,
+				  U8 color);
+
+extern void _GfxTk_CopyScreenRect(VgaConfig *config,
+				  Vector2d source,
+				  Vector2d destination,
+				  Vector2d size);
+
+extern void _GfxTk_XorScreenSprite(VgaConfig *config,
+				   U16 page,
+				   Vector2d position,
+				   const VgaSprite *sprite,
+				   U8 color);
+
 
 members(Vga) {
+    .SetMode = _GfxTk_SetMode,
+    .GetPageSize = _GfxTk_GetPageSize,
     .EnableOutput = _GfxTk_EnableOutput,
     .DisableOutput = _GfxTk_DisableOutput,
     .SetBitmask = _GfxTk_SetBitmask,
     .SetPlaneMask = _GfxTk_SetPlaneMask,
     .PauseUntilVSync = _GfxTk_PauseUntilVSync,
     .SetPalette = _GfxTk_SetPalette,
-    .UseColor = _GfxTk_UseColor
+    .UseColor = _GfxTk_UseColor,
+    .SetPaletteRange = _GfxTk_SetPaletteRange,
+    .QueuePaletteRange = _GfxTk_QueuePaletteRange,
+    .HasQueuedPalette = _GfxTk_HasQueuedPalette,
+    .UseColorRange = _GfxTk_UseColorRange,
+    .SetWriteMode = _GfxTk_SetWriteMode,
+    .SetSetReset = _GfxTk_SetSetReset,
+    .EnableSetReset = _GfxTk_EnableSetReset,
+    .SetLogicOperation = _GfxTk_SetLogicOperation,
+    .SetStartAddress = _GfxTk_SetStartAddress,
+    .SetLineCompare = _GfxTk_SetLineCompare,
+    .EnablePageFlipping = _GfxTk_EnablePageFlipping,
+    .DisablePageFlipping = _GfxTk_DisablePageFlipping,
+    .FillScreenRect = _GfxTk_FillScreenRect,
+    .CopyScreenRect = _GfxTk_CopyScreenRect,
+    .XorScreenSprite = _GfxTk_XorScreenSprite
 };
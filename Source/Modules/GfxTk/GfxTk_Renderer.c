@@ -112,10 +112,10 @@ void _GfxTk_RenderCharBitmap(RenderChar *destination,
   U8 whitespaceLeft = bitmapSig ? _GetFreeBitsLeft(bitmapSig) : 0;
   U8 whitespaceRight = bitmapSig ? _GetFreeBitsRight(bitmapSig) : 0;
 
-  // Align left
-  if (bitmapSig)
-    _ShiftBitmap(bitmap, whitespaceLeft);
+  // Align left (on the copy, the source may be read-only font data)
   _CopyBitmap8x8(bitmap, destination->Bitmap);
+  if (bitmapSig)
+    _ShiftBitmap(&destination->Bitmap, whitespaceLeft);
 
   // Set width without whitespace
   destination->Size.X = 8 - whitespaceLeft - whitespaceRight;
@@ -134,6 +134,7 @@ void _GfxTk_RenderFont(Font* destination,
 
   destination->CharSpacing = FONT_DEFAULT_CHARSPACING;
   destination->LineSpacing = FONT_DEFAULT_LINESPACING;
+  destination->Cache = null;
 
   for (U8 charIndex = 0; charIndex < FONT_CHAR_COUNT; charIndex++) {
     RenderChar *nextChar = &destination->Char[charIndex];
@@ -144,12 +145,72 @@ void _GfxTk_RenderFont(Font* destination,
 
 
 
-static inline void _FillRow(VgaConfig *config,
-			    Vector2d position,
-			    U16 width,
-			    U8 color) {
-  if (!width)
+// Four neighbouring bytes of a plane
+typedef U32 __attribute__((may_alias)) FillSpan;
+
+
+// Fill a short span of a row. A plain loop beats the startup cost of
+// string instructions here.
+static inline void _FillSpan(U8 *destination, U8 value, U16 count) {
+  FillSpan pattern = value * 0x01010101;
+
+  for (; count >= sizeof(FillSpan); count -= sizeof(FillSpan), destination += sizeof(FillSpan))
+    *(FillSpan*)destination = pattern;
+
+  while (count--)
+    *destination++ = value;
+}
+
+
+// Fill a large block of memory with a byte value, a dword at a time
+static inline void _FillBytes(U8 *destination, U8 value, U32 count) {
+  U32 dwords  = count / 4;
+  U32 bytes   = count % 4;
+  U32 pattern = value * 0x01010101;
+
+  __asm__ __volatile__ (
+			"cld\n\t"
+			"rep stosl\n\t"
+			"movl %3, %%ecx\n\t"
+			"rep stosb\n\t"
+			: "+D"(destination), "+c"(dwords)
+			: "a"(pattern), "r"(bytes)
+			: "memory"
+			);
+}
+
+
+// Fill an area of a chunky backbuffer
+static inline void _FillChunkyRect(VgaConfig *config,
+				   Vector2d position,
+				   U16 width,
+				   U16 height,
+				   U8 color) {
+  U8 *row = (U8*)config->Backbuffer + (position.Y * config->Resolution.X) + position.X;
+
+  // Full width rows are one contiguous span
+  if (width == config->Resolution.X) {
+    _FillBytes(row, color, width * height);
+    return;
+  }
+
+  for (U16 rowIndex = 0; rowIndex < height; rowIndex++, row += config->Resolution.X)
+    _FillSpan(row, color, width);
+}
+
+
+static inline void _FillRect(VgaConfig *config,
+			     Vector2d position,
+			     U16 width,
+			     U16 height,
+			     U8 color) {
+  if (!width || !height)
+    return;
+
+  if (config->Format == VgaChunky) {
+    _FillChunkyRect(config, position, width, height, color);
     return;
+  }
 
   const U16	bytesPerRow   = config->Resolution.X / 8;
   const U32	bytesPerPlane = bytesPerRow * config->Resolution.Y;
@@ -158,38 +219,53 @@ static inline void _FillRow(VgaConfig *config,
   const U16	lastPixelX     = position.X + width - 1;
   const U16	lastByteIndex  = lastPixelX >> 3;
 
-  const U8	maskLeft  = 0xff >> (position.X & 7);
-  const U8	maskRight = 0xff << (7 - (lastPixelX & 7));
+  U8	maskLeft  = 0xff >> (position.X & 7);
+  U8	maskRight = 0xff << (7 - (lastPixelX & 7));
 
-  for (U8 plane = 0; plane < config->PlaneCount; plane++) {
-    U8 *planeAddress = config->Backbuffer + (bytesPerPlane * plane);
-    U8 *rowAddress = planeAddress + (position.Y * bytesPerRow);
+  // The bytes in between the edges are filled as a whole; so are edges
+  // that are completely covered. A mask of 0 means there is no edge.
+  U16	middleStart = firstByteIndex;
+  U16	middleEnd   = lastByteIndex + 1;
+
+  if (firstByteIndex == lastByteIndex) {
+    maskLeft &= maskRight;
+    maskRight = 0xff;
+  }
+
+  if (maskLeft != 0xff)
+    middleStart++;
+  else
+    maskLeft = 0;
+
+  if (maskRight != 0xff)
+    middleEnd--;
+  else
+    maskRight = 0;
+
+  const U16	middleCount = middleEnd > middleStart ? middleEnd - middleStart : 0;
+
+  U8 *planeRow = (U8*)config->Backbuffer + (position.Y * bytesPerRow);
+  for (U8 plane = 0; plane < config->PlaneCount; plane++, planeRow += bytesPerPlane) {
     U8 fillValue = (color & (1 << plane))
       ? 0xff
       : 0x00;
 
-    if (firstByteIndex == lastByteIndex) {
-      U8 mask = maskLeft & maskRight;
-      if (fillValue)
-	rowAddress[firstByteIndex] |= mask;
-      else
-	rowAddress[firstByteIndex] &= ~mask;
+    // Full width rows are one contiguous span
+    if (middleCount == bytesPerRow) {
+      _FillBytes(planeRow, fillValue, bytesPerRow * height);
       continue;
     }
 
-    if (fillValue)
-      rowAddress[firstByteIndex] |= maskLeft;
-    else 
-      rowAddress[firstByteIndex] &= ~maskLeft;
-    
-    for (U16 byteIndex = firstByteIndex + 1; byteIndex < lastByteIndex; byteIndex++)
-      rowAddress[byteIndex] = fillValue;
+    U8 *rowAddress = planeRow;
+    for (U16 row = 0; row < height; row++, rowAddress += bytesPerRow) {
+      if (maskLeft)
+	rowAddress[firstByteIndex] = (rowAddress[firstByteIndex] & ~maskLeft) | (fillValue & maskLeft);
 
-    if (fillValue)
-      rowAddress[lastByteIndex] |= maskRight;
-    else
-      rowAddress[lastByteIndex] &= ~maskRight;
-    
+      _FillSpan(rowAddress + middleStart, fillValue, middleCount);
+
+      if (maskRight)
+	rowAddress[lastByteIndex] = (rowAddress[lastByteIndex] & ~maskRight) | (fillValue & maskRight);
+    }
   }
 }
 
@@ -209,16 +285,87 @@ static inline U16 _GetHeight(VgaConfig *config, Vector2d position, Vector2d size
 
 
 
+// Get the area drawing is limited to (the screen if no clip is set)
+static inline Rect2d _GetClip(VgaConfig *config) {
+  if (config->ClipDepth)
+    return config->ClipRects[config->ClipDepth - 1];
+
+  return (Rect2d) {
+    .Position = { 0, 0 },
+    .Size = config->Resolution
+  };
+}
+
+
+// Intersect an area with the clip rect. Returns false if nothing is left.
+static inline bool _ClipArea(VgaConfig *config, Vector2d position, Vector2d size, Rect2d *result) {
+  const Rect2d clip = _GetClip(config);
+
+  U32 left   = position.X > clip.Position.X ? position.X : clip.Position.X;
+  U32 top    = position.Y > clip.Position.Y ? position.Y : clip.Position.Y;
+  U32 right  = (U32)position.X + size.X;
+  U32 bottom = (U32)position.Y + size.Y;
+
+  if (right > (U32)clip.Position.X + clip.Size.X)
+    right = (U32)clip.Position.X + clip.Size.X;
+  if (bottom > (U32)clip.Position.Y + clip.Size.Y)
+    bottom = (U32)clip.Position.Y + clip.Size.Y;
+
+  if (right <= left || bottom <= top)
+    return false;
+
+  *result = (Rect2d) {
+    .Position = { left, top },
+    .Size = { right - left, bottom - top }
+  };
+
+  return true;
+}
+
+
+// Fill the visible part of an area (without invalidating it)
+static inline void _FillClipped(VgaConfig *config,
+				Vector2d position,
+				Vector2d size,
+				U8 color) {
+  Rect2d area;
+  if (_ClipArea(config, position, size, &area))
+    _FillRect(config, area.Position, area.Size.X, area.Size.Y, color);
+}
+
+
+bool _GfxTk_PushClip(VgaConfig *config, Vector2d position, Vector2d size) {
+  if (config->ClipDepth >= VGA_CLIP_DEPTH)
+    return false;
+
+  // Nested clips never reach beyond the outer one; an empty clip hides
+  // everything
+  Rect2d clip = { .Position = position };
+  _ClipArea(config, position, size, &clip);
+
+  config->ClipRects[config->ClipDepth++] = clip;
+  return true;
+}
+
+
+void _GfxTk_PopClip(VgaConfig *config) {
+  if (config->ClipDepth)
+    config->ClipDepth--;
+}
+
+
+
 void _GfxTk_RenderFilledRect(VgaConfig *config,
 			     Vector2d position,
 			     Vector2d size,
 			     U8 color) {
-  const U16 width = _GetWidth(config, position, size);
-  const U16 height = _GetHeight(config, position, size);
+  Rect2d area;
+  if (!_ClipArea(config, position, size, &area))
+    return;
 
-  const U16 lastRow = position.Y + height;
-  for (U16 row = position.Y; row < lastRow; row++)
-    _FillRow(config, (Vector2d) { .X = position.X, .Y = row }, width, color);
+  _FillRect(config, area.Position, area.Size.X, area.Size.Y, color);
+
+  Renderer.Invalidate(config, area.Position, area.Size);
 }
 
 
@@ -227,103 +374,934 @@ void _GfxTk_RenderRect(VgaConfig *config,
 		       Vector2d size,
 		       U8 thickness,
 		       U8 color) {
-  if (!size.X || !size.Y)
+  Rect2d area;
+  if (!_ClipArea(config, position, size, &area))
     return;
 
-  const U16 width = _GetWidth(config, position, size);
-  const U16 height = _GetHeight(config, position, size);
-  const U16 lastRow = position.Y + height;
-  
-  // Draw top row
-  const U16 topEnd = position.Y + thickness;
-  for (U16 row = position.Y; row < topEnd; row++)
-    _FillRow(config, (Vector2d) { .X = position.X, .Y = row }, width, color);
+  const U16 thicknessX = thickness < size.X ? thickness : size.X;
+  const U16 thicknessY = thickness < size.Y ? thickness : size.Y;
 
-  // Draw bottom row
-  const U16 bottomStart = position.Y + height - thickness;
-  for (U16 row = bottomStart; row < lastRow; row++)
-    _FillRow(config, (Vector2d) { .X = position.X, .Y = row }, width, color);
+  // Draw top and bottom row
+  _FillClipped(config, position, (Vector2d) { size.X, thicknessY }, color);
+  _FillClipped(config, (Vector2d) { position.X, position.Y + size.Y - thicknessY }, (Vector2d) { size.X, thicknessY }, color);
 
-  // Draw left border
-  const U16 borderStart = position.Y + thickness;
-  for (U16 row = borderStart; row < bottomStart; row++) {
-    _FillRow(config, (Vector2d) { .X = position.X, .Y = row}, thickness, color);
-    _FillRow(config, (Vector2d) { .X = position.X + width - thickness, .Y = row}, thickness, color);
+  // Draw left and right border
+  if (size.Y > 2 * thicknessY) {
+    const U16 borderStart = position.Y + thicknessY;
+    const U16 borderHeight = size.Y - 2 * thicknessY;
+
+    _FillClipped(config, (Vector2d) { position.X, borderStart }, (Vector2d) { thicknessX, borderHeight }, color);
+    _FillClipped(config, (Vector2d) { position.X + size.X - thicknessX, borderStart }, (Vector2d) { thicknessX, borderHeight }, color);
   }
+
+  Renderer.Invalidate(config, area.Position, area.Size);
 }
 
 
-U16 _GfxTk_RenderChar(VgaConfig *config,
-		       Vector2d position,
-		       RenderChar *glyph,
-		       U8 color) {
+// Two neighbouring bytes of a plane row (first byte in the low half)
+typedef U16 __attribute__((may_alias)) GlyphSpan;
+
+
+// Apply the shifted rows of a glyph to a plane. Wide rows cover two
+// bytes; otherwise only the low half of each row is used.
+static inline void _BlitGlyphRows(U8 *destination,
+				  const U16 *rows,
+				  U16 rowCount,
+				  U16 bytesPerRow,
+				  bool set,
+				  bool wide) {
+  if (wide) {
+    if (set)
+      for (U16 rowIndex = 0; rowIndex < rowCount; rowIndex++, destination += bytesPerRow)
+	*(GlyphSpan*)destination |= rows[rowIndex];
+    else
+      for (U16 rowIndex = 0; rowIndex < rowCount; rowIndex++, destination += bytesPerRow)
+	*(GlyphSpan*)destination &= ~rows[rowIndex];
+    return;
+  }
 
+  if (set)
+    for (U16 rowIndex = 0; rowIndex < rowCount; rowIndex++, destination += bytesPerRow)
+      *destination |= (U8)rows[rowIndex];
+  else
+    for (U16 rowIndex = 0; rowIndex < rowCount; rowIndex++, destination += bytesPerRow)
+      *destination &= (U8)~rows[rowIndex];
+}
+
+
+// Set the pixels of a chunky row that the bits of a mask byte stand for
+static inline void _ExpandMask(U8 *destination, U8 mask, U8 color) {
+  for (; mask; mask <<= 1, destination++)
+    if (mask & 0x80)
+      *destination = color;
+}
+
+
+// Shift a glyph row to a sub-byte offset, as the two bytes it covers
+static inline U16 _ShiftGlyphRow(U8 bitmapRow, U8 shift) {
+  return (U8)(bitmapRow >> shift) | (U16)((U8)(bitmapRow << (8 - shift)) << 8);
+}
+
+
+// Draw a range of glyph rows, already shifted to the sub-byte offset of
+// the position, into every plane. The rows have to be clipped already.
+static inline void _BlitShiftedGlyph(VgaConfig *config,
+				     Vector2d position,
+				     const U16 *rows,
+				     U16 firstRow,
+				     U16 lastRow,
+				     U8 color) {
   const U16	bytesPerRow   = config->Resolution.X / 8;
   const U32	bytesPerPlane = bytesPerRow * config->Resolution.Y;
-  
-  for (U16 rowIndex = 0; rowIndex < glyph->Size.Y; rowIndex++) {
-    U8 bitmapRow = glyph->Bitmap[rowIndex];
 
-    for (U16 columnIndex = 0; columnIndex < 8; columnIndex++) {
-      if ((bitmapRow & (1<< (7 - columnIndex))) == 0)
-	continue;
-      
-      U16 positionX = position.X + columnIndex;
-      U16 positionY = position.Y + rowIndex;
+  const U16	byteIndex = position.X >> 3;
+  // A glyph that is not byte aligned spills into the next byte (unless
+  // that one is off screen)
+  const bool	spills    = (position.X & 7) && byteIndex + 1 < bytesPerRow;
 
-      if (positionX >= config->Resolution.X ||
-	  positionY >= config->Resolution.Y)
-	continue;
+  if (config->Format == VgaChunky) {
+    U8 *row = (U8*)config->Backbuffer + ((position.Y + firstRow) * config->Resolution.X) + (byteIndex << 3);
 
-      U8 planeMask = 1;
-      for (U8 plane = 0; plane < config->PlaneCount; plane++, planeMask <<= 1) {
-	U8 planeBit = (color & planeMask)
-	  ? 1
-	  : 0;
+    for (U16 rowIndex = firstRow; rowIndex < lastRow; rowIndex++, row += config->Resolution.X) {
+      _ExpandMask(row, (U8)rows[rowIndex], color);
+      if (spills)
+	_ExpandMask(row + 8, rows[rowIndex] >> 8, color);
+    }
+    return;
+  }
 
-	U32 byteOffset = (positionY * (config->Resolution.X / 8)) + (positionX / 8);
-	U8 bitmask = 0x80 >> (positionX & 7);
+  U8 *destination = (U8*)config->Backbuffer + ((position.Y + firstRow) * bytesPerRow) + byteIndex;
+  for (U8 plane = 0; plane < config->PlaneCount; plane++, destination += bytesPerPlane)
+    _BlitGlyphRows(destination, rows + firstRow, lastRow - firstRow, bytesPerRow, color & (1 << plane), spills);
+}
 
-	U8* destination = config->Backbuffer + (plane * bytesPerPlane) + byteOffset;
-	if (planeBit)
-	  *destination |= bitmask;
-	else
-	  *destination &= ~bitmask;
-      }
-      
-    }
+
+static inline U16 _GetGlyphRowCount(const RenderChar *glyph) {
+  return glyph->Size.Y < sizeof(Bitmap8x8)
+    ? glyph->Size.Y
+    : sizeof(Bitmap8x8);
+}
+
+
+// Draw the visible part of an 8 pixels wide column of glyph rows (which
+// are a number of bytes apart) into the backbuffer (without
+// invalidating it)
+static inline void _BlitGlyphColumn(VgaConfig *config,
+				    Vector2d position,
+				    const U8 *bitmap,
+				    U16 bytesPerRow,
+				    U16 rowCount,
+				    U8 color) {
+  Rect2d area;
+  if (!_ClipArea(config, position, (Vector2d) { 8, rowCount }, &area))
+    return;
+
+  const U16 firstColumn = area.Position.X - position.X;
+  const U16 firstRow = area.Position.Y - position.Y;
+  const U16 lastRow = firstRow + area.Size.Y;
+
+  // Drop the columns outside of the clip
+  const U8 columnMask = (U8)(0xff >> firstColumn) & (U8)(0xff << (8 - firstColumn - area.Size.X));
+
+  // Shift every glyph row into place once for all planes
+  U16 rows[PACKED_FONT_MAX_SIZE];
+  for (U16 rowIndex = firstRow; rowIndex < lastRow; rowIndex++)
+    rows[rowIndex] = _ShiftGlyphRow(bitmap[rowIndex * bytesPerRow] & columnMask, position.X & 7);
+
+  _BlitShiftedGlyph(config, position, rows, firstRow, lastRow, color);
+}
+
+
+// Draw the visible part of a glyph into the backbuffer (without
+// invalidating it)
+static inline void _BlitGlyph(VgaConfig *config,
+			      Vector2d position,
+			      const RenderChar *glyph,
+			      U8 color) {
+  _BlitGlyphColumn(config, position, glyph->Bitmap, 1, _GetGlyphRowCount(glyph), color);
+}
+
+
+// Get the pre-shifted rows of a glyph from the cache of its font. The
+// variants for an offset are built for all glyphs when first needed.
+static inline const U16* _GetCachedGlyphRows(const Font *font, const RenderChar *glyph, U8 shift) {
+  GlyphCache *cache = font->Cache;
+
+  if (!(cache->BuiltOffsets & (1 << shift))) {
+    for (U8 charIndex = 0; charIndex < FONT_CHAR_COUNT; charIndex++)
+      for (U8 rowIndex = 0; rowIndex < sizeof(Bitmap8x8); rowIndex++)
+	cache->Rows[shift][charIndex][rowIndex] = _ShiftGlyphRow(font->Char[charIndex].Bitmap[rowIndex], shift);
+
+    cache->BuiltOffsets |= 1 << shift;
   }
 
+  return cache->Rows[shift][glyph - font->Char];
+}
+
+
+U16 _GfxTk_RenderChar(VgaConfig *config,
+		       Vector2d position,
+		       const RenderChar *glyph,
+		       U8 color) {
+  if (!glyph)
+    return 0;
+
+  Rect2d area;
+  if (!_ClipArea(config, position, glyph->Size, &area))
+    return glyph->Size.X;
+
+  _BlitGlyph(config, position, glyph, color);
+  Renderer.Invalidate(config, area.Position, area.Size);
+
   return glyph->Size.X;
 }
 
 
-RenderChar* _GfxTk_GetGlyph(Font *font, char asciiChar) {
+// Get the glyph of a char, or null if the font has none
+static inline const RenderChar* _FindGlyph(const Font *font, char asciiChar) {
+  const U8 glyphIndex = (U8)asciiChar - ' ';
+
+  return glyphIndex < FONT_CHAR_COUNT ? &font->Char[glyphIndex] : null;
+}
+
+
+const RenderChar* _GfxTk_GetGlyph(const Font *font, char asciiChar) {
   if (!font)
     return null;
 
-  return &font->Char[asciiChar - 32];
+  return _FindGlyph(font, asciiChar);
+}
+
+
+// The widest part of a text run that is composed at once (in bytes)
+#define _GFXTK_RUN_MAX_BYTES 128
+
+// The scanline masks a text run is composed into (one per glyph row)
+static U8 _RunMask[sizeof(Bitmap8x8)][_GFXTK_RUN_MAX_BYTES];
+
+
+// Apply a scanline mask to a plane row, four bytes at a time
+static inline void _ApplySpanMask(U8 *destination, const U8 *mask, U16 count, bool set) {
+  U16 index = 0;
+
+  if (set) {
+    for (; index + sizeof(FillSpan) <= count; index += sizeof(FillSpan))
+      *(FillSpan*)(destination + index) |= *(const FillSpan*)(mask + index);
+    for (; index < count; index++)
+      destination[index] |= mask[index];
+  } else {
+    for (; index + sizeof(FillSpan) <= count; index += sizeof(FillSpan))
+      *(FillSpan*)(destination + index) &= ~*(const FillSpan*)(mask + index);
+    for (; index < count; index++)
+      destination[index] &= ~mask[index];
+  }
+}
+
+
+// Compose a range of glyph rows into the run mask, which starts at a
+// certain byte of the plane rows
+static inline void _ComposeGlyph(const Font *font,
+				 const RenderChar *glyph,
+				 U16 x,
+				 U16 maskStart,
+				 U16 maskBytes,
+				 U16 firstRow,
+				 U16 lastRow) {
+  const I32 byteIndex = (I32)(x >> 3) - maskStart;
+  if (byteIndex < -1 || byteIndex >= maskBytes)
+    return;
+
+  const U16 rowCount = _GetGlyphRowCount(glyph);
+  if (lastRow > rowCount)
+    lastRow = rowCount;
+
+  const U8 shift = x & 7;
+
+  // Most glyphs cover two bytes of the mask
+  if (byteIndex >= 0 && byteIndex + 1 < maskBytes) {
+    U8 *mask = &_RunMask[firstRow][byteIndex];
+
+    if (font->Cache) {
+      const U16 *rows = _GetCachedGlyphRows(font, glyph, shift);
+      for (U16 rowIndex = firstRow; rowIndex < lastRow; rowIndex++, mask += _GFXTK_RUN_MAX_BYTES)
+	*(GlyphSpan*)mask |= rows[rowIndex];
+    } else
+      for (U16 rowIndex = firstRow; rowIndex < lastRow; rowIndex++, mask += _GFXTK_RUN_MAX_BYTES)
+	*(GlyphSpan*)mask |= _ShiftGlyphRow(glyph->Bitmap[rowIndex], shift);
+    return;
+  }
+
+  // The others stick out of one of its ends
+  for (U16 rowIndex = firstRow; rowIndex < lastRow; rowIndex++) {
+    U16 row = _ShiftGlyphRow(glyph->Bitmap[rowIndex], shift);
+
+    if (byteIndex >= 0)
+      _RunMask[rowIndex][byteIndex] |= (U8)row;
+    else
+      _RunMask[rowIndex][0] |= row >> 8;
+  }
 }
 
 
 void _GfxTk_RenderAsciiZ(VgaConfig *config,
 			 Vector2d position,
 			 char *text,
-			 Font *font,
+			 const Font *font,
 			 U8 color) {
+  if (!font || !text)
+    return;
+
+  // Measure the run (glyph bitmaps are always 8 pixels wide)
   U16 offset = 0;
+  U16 extent = 0;
+  U16 height = 0;
   for (char *textPtr = text; *textPtr; textPtr++) {
-    Vector2d nextPos = {position.X + offset, position.Y };
-    RenderChar *nextGlyph = Renderer.GetGlyph(font, *textPtr);
-    Renderer.RenderChar(config, nextPos, nextGlyph, color);
-    offset += nextGlyph->Size.X + font->CharSpacing;
+    const RenderChar *glyph = _FindGlyph(font, *textPtr);
+    if (!glyph)
+      continue;
+
+    if (offset + 8 > extent)
+      extent = offset + 8;
+    if (_GetGlyphRowCount(glyph) > height)
+      height = _GetGlyphRowCount(glyph);
+
+    offset += glyph->Size.X + font->CharSpacing;
+  }
+
+  Rect2d area;
+  if (!_ClipArea(config, position, (Vector2d) { extent, height }, &area))
+    return;
+
+  const U16	bytesPerRow   = config->Resolution.X / 8;
+  const U32	bytesPerPlane = bytesPerRow * config->Resolution.Y;
+
+  const U16	firstRow  = area.Position.Y - position.Y;
+  const U16	lastRow   = firstRow + area.Size.Y;
+  const U16	lastX     = area.Position.X + area.Size.X - 1;
+  const U16	firstByte = area.Position.X >> 3;
+  const U16	endByte   = (lastX >> 3) + 1;
+
+  for (U16 maskStart = firstByte; maskStart < endByte; maskStart += _GFXTK_RUN_MAX_BYTES) {
+    const U16 maskBytes = endByte - maskStart < _GFXTK_RUN_MAX_BYTES
+      ? endByte - maskStart
+      : _GFXTK_RUN_MAX_BYTES;
+
+    for (U16 rowIndex = firstRow; rowIndex < lastRow; rowIndex++)
+      _FillSpan(_RunMask[rowIndex], 0, maskBytes);
+
+    // Compose all glyphs of the line before touching any plane
+    U16 glyphX = position.X;
+    for (char *textPtr = text; *textPtr; textPtr++) {
+      const RenderChar *glyph = _FindGlyph(font, *textPtr);
+      if (!glyph)
+	continue;
+
+      _ComposeGlyph(font, glyph, glyphX, maskStart, maskBytes, firstRow, lastRow);
+      glyphX += glyph->Size.X + font->CharSpacing;
+    }
+
+    // Drop the pixels outside of the clip
+    for (U16 rowIndex = firstRow; rowIndex < lastRow; rowIndex++) {
+      if (maskStart == firstByte)
+	_RunMask[rowIndex][0] &= 0xff >> (area.Position.X & 7);
+      if (maskStart + maskBytes == endByte)
+	_RunMask[rowIndex][maskBytes - 1] &= 0xff << (7 - (lastX & 7));
+    }
+
+    if (config->Format == VgaChunky) {
+      U8 *row = (U8*)config->Backbuffer + (area.Position.Y * config->Resolution.X) + (maskStart << 3);
+
+      for (U16 rowIndex = firstRow; rowIndex < lastRow; rowIndex++, row += config->Resolution.X)
+	for (U16 index = 0; index < maskBytes; index++)
+	  _ExpandMask(row + (index << 3), _RunMask[rowIndex][index], color);
+      continue;
+    }
+
+    // Then apply the masks to one plane after the other
+    U8 *planeStart = (U8*)config->Backbuffer + (area.Position.Y * bytesPerRow) + maskStart;
+    for (U8 plane = 0; plane < config->PlaneCount; plane++, planeStart += bytesPerPlane) {
+      U8 *destination = planeStart;
+
+      for (U16 rowIndex = firstRow; rowIndex < lastRow; rowIndex++, destination += bytesPerRow)
+	_ApplySpanMask(destination, _RunMask[rowIndex], maskBytes, color & (1 << plane));
+    }
+  }
+
+  // Invalidate the whole line at once
+  if (_ClipArea(config, position, (Vector2d) { offset, height }, &area))
+    Renderer.Invalidate(config, area.Position, area.Size);
+}
+
+
+U16 _GfxTk_MeasureText(const Font *font, const char *text, U32 length) {
+  if (!font || !text)
+    return 0;
+
+  U16 width = 0;
+  for (U32 index = 0; index < length && text[index] && text[index] != '\n'; index++) {
+    const RenderChar *glyph = _FindGlyph(font, text[index]);
+    if (glyph)
+      width += glyph->Size.X + font->CharSpacing;
+  }
+
+  return width;
+}
+
+
+U32 _GfxTk_LayoutText(const Font *font,
+		      const char *text,
+		      U32 length,
+		      U16 width,
+		      TextRun *runs,
+		      U32 maxRuns) {
+  if (!font || !text || !runs)
+    return 0;
+
+  U32 runCount = 0;
+  U32 start = 0;
+
+  while (runCount < maxRuns) {
+    U32 index = start;
+    U16 lineWidth = 0;
+
+    // The last space seen (where the line can be wrapped)
+    U32 spaceIndex = start;
+    U16 spaceWidth = 0;
+
+    U32 end;
+    U32 next;
+
+    for (;;) {
+      if (index >= length || !text[index]) {
+	end = next = index;
+	break;
+      }
+
+      if (text[index] == '\n') {
+	end = index;
+	next = index + 1;
+	break;
+      }
+
+      const RenderChar *glyph = _FindGlyph(font, text[index]);
+      const U16 glyphWidth = glyph ? glyph->Size.X : 0;
+
+      if (text[index] == ' ') {
+	spaceIndex = index;
+	spaceWidth = lineWidth;
+      }
+
+      // Every line takes at least one char, even if it does not fit
+      if (lineWidth + glyphWidth > width && index > start) {
+	if (spaceIndex > start) {
+	  // Drop the space the line is wrapped at
+	  end = spaceIndex;
+	  next = spaceIndex + 1;
+	  lineWidth = spaceWidth;
+	} else
+	  end = next = index;
+	break;
+      }
+
+      if (glyph)
+	lineWidth += glyphWidth + font->CharSpacing;
+      index++;
+    }
+
+    runs[runCount++] = (TextRun) {
+      .Start = start,
+      .Length = end - start,
+      .Width = lineWidth
+    };
+
+    if (next >= length || !text[next]) {
+      // A line break at the end starts one more (empty) line
+      if (next > end && text[end] == '\n' && runCount < maxRuns)
+	runs[runCount++] = (TextRun) { .Start = next };
+      break;
+    }
+
+    start = next;
+  }
+
+  return runCount;
+}
+
+
+// Find a sequence of rows in a bitmap blob. Returns the size of the blob
+// if it is not in there.
+static inline U32 _FindRows(const U8 *bitmaps, U32 size, const U8 *rows, U8 rowCount) {
+  for (U32 offset = 0; offset + rowCount <= size; offset++) {
+    U8 rowIndex = 0;
+    while (rowIndex < rowCount && bitmaps[offset + rowIndex] == rows[rowIndex])
+      rowIndex++;
+
+    if (rowIndex == rowCount)
+      return offset;
+  }
+
+  return size;
+}
+
+
+U32 _GfxTk_PackFont(const Font *source, void *image, U32 capacity) {
+  const U32 tableSize = sizeof(PackedFontHeader) + FONT_CHAR_COUNT * sizeof(PackedGlyph);
+  if (!source || !image || capacity < tableSize)
+    return 0;
+
+  PackedFontHeader *header = image;
+  PackedGlyph *glyphs = (PackedGlyph*)(header + 1);
+  U8 *bitmaps = (U8*)(glyphs + FONT_CHAR_COUNT);
+
+  U32 bitmapSize = 0;
+  U8 height = 0;
+
+  for (U8 charIndex = 0; charIndex < FONT_CHAR_COUNT; charIndex++) {
+    const RenderChar *glyph = &source->Char[charIndex];
+    U8 lastRow = _GetGlyphRowCount(glyph);
+    if (lastRow > height)
+      height = lastRow;
+
+    // Only keep the rows between the first and the last set one
+    U8 firstRow = 0;
+    while (firstRow < lastRow && !glyph->Bitmap[firstRow])
+      firstRow++;
+    while (lastRow > firstRow && !glyph->Bitmap[lastRow - 1])
+      lastRow--;
+
+    const U8 rowCount = lastRow - firstRow;
+
+    // Glyphs share rows with earlier ones where possible
+    U32 offset = _FindRows(bitmaps, bitmapSize, glyph->Bitmap + firstRow, rowCount);
+    if (offset == bitmapSize) {
+      if (tableSize + bitmapSize + rowCount > capacity || bitmapSize + rowCount > 0xffff)
+	return 0;
+
+      for (U8 rowIndex = 0; rowIndex < rowCount; rowIndex++)
+	bitmaps[bitmapSize++] = glyph->Bitmap[firstRow + rowIndex];
+    }
+
+    glyphs[charIndex] = (PackedGlyph) {
+      .Offset = offset,
+      .Width = glyph->Size.X,
+      .Advance = glyph->Size.X + source->CharSpacing,
+      .Top = rowCount ? firstRow : 0,
+      .RowCount = rowCount
+    };
+  }
+
+  *header = (PackedFontHeader) {
+    .Magic = PACKED_FONT_MAGIC,
+    .Height = height,
+    .LineSpacing = source->LineSpacing,
+    .GlyphCount = FONT_CHAR_COUNT,
+    .BitmapSize = bitmapSize
+  };
+
+  return tableSize + bitmapSize;
+}
+
+
+bool _GfxTk_LoadPackedFont(PackedFont *font, const void *image, U32 size) {
+  if (!font || !image || size < sizeof(PackedFontHeader))
+    return false;
+
+  const PackedFontHeader *header = image;
+  const U32 tableSize = sizeof(PackedFontHeader) + header->GlyphCount * sizeof(PackedGlyph);
+
+  if (header->Magic != PACKED_FONT_MAGIC
+      || header->Height > PACKED_FONT_MAX_SIZE
+      || header->GlyphCount > FONT_CHAR_COUNT
+      || tableSize + header->BitmapSize > size)
+    return false;
+
+  // Every glyph has to stay within the line and the bitmap blob
+  const PackedGlyph *glyphs = (const PackedGlyph*)(header + 1);
+  for (U16 glyphIndex = 0; glyphIndex < header->GlyphCount; glyphIndex++) {
+    const PackedGlyph *glyph = &glyphs[glyphIndex];
+    const U8 bytesPerRow = glyph->Width > 8 ? 2 : 1;
+
+    if (glyph->Width > PACKED_FONT_MAX_SIZE
+	|| glyph->Top + glyph->RowCount > header->Height
+	|| glyph->Offset + glyph->RowCount * bytesPerRow > header->BitmapSize)
+      return false;
+  }
+
+  *font = (PackedFont) {
+    .Height = header->Height,
+    .LineSpacing = header->LineSpacing,
+    .GlyphCount = header->GlyphCount,
+    .Glyphs = glyphs,
+    .Bitmaps = (const U8*)(glyphs + header->GlyphCount)
+  };
+
+  return true;
+}
+
+
+void _GfxTk_RenderPackedAsciiZ(VgaConfig *config,
+			       Vector2d position,
+			       char *text,
+			       const PackedFont *font,
+			       U8 color) {
+  if (!font || !text)
+    return;
+
+  U16 offset = 0;
+  for (char *textPtr = text; *textPtr; textPtr++) {
+    const U8 glyphIndex = (U8)*textPtr - ' ';
+    if (glyphIndex >= font->GlyphCount)
+      continue;
+
+    const PackedGlyph *glyph = &font->Glyphs[glyphIndex];
+    const U8 *bitmap = font->Bitmaps + glyph->Offset;
+    Vector2d nextPos = { position.X + offset, position.Y + glyph->Top };
+
+    // Wide glyphs are drawn as two columns
+    if (glyph->Width > 8) {
+      _BlitGlyphColumn(config, nextPos, bitmap, 2, glyph->RowCount, color);
+      _BlitGlyphColumn(config, (Vector2d) { nextPos.X + 8, nextPos.Y }, bitmap + 1, 2, glyph->RowCount, color);
+    } else
+      _BlitGlyphColumn(config, nextPos, bitmap, 1, glyph->RowCount, color);
+
+    offset += glyph->Advance;
+  }
+
+  // Invalidate the whole line at once
+  Rect2d area;
+  if (_ClipArea(config, position, (Vector2d) { offset, font->Height }, &area))
+    Renderer.Invalidate(config, area.Position, area.Size);
+}
+
+
+void _GfxTk_EnableGlyphCache(Font *font, GlyphCache *cache) {
+  if (!font)
+    return;
+
+  font->Cache = cache;
+  if (cache)
+    cache->BuiltOffsets = 0;
+}
+
+
+// Read the 8 bits of a row starting at a bit offset; bits outside the
+// row are 0
+static inline U8 _ReadRowBits(const U8 *row, U16 bytesPerRow, I32 bitOffset) {
+  I32 byteIndex = bitOffset >> 3;
+  U8 shift = bitOffset & 7;
+
+  U8 high = (byteIndex >= 0 && byteIndex < bytesPerRow)
+    ? row[byteIndex]
+    : 0;
+  U8 low = (shift && byteIndex + 1 >= 0 && byteIndex + 1 < bytesPerRow)
+    ? row[byteIndex + 1]
+    : 0;
+
+  return (U8)(high << shift) | (shift ? low >> (8 - shift) : 0);
+}
+
+
+// Describes one row of a blit in destination bytes
+typedef struct {
+  U16 FirstByte;
+  U16 LastByte;
+  U8 MaskLeft;
+  U8 MaskRight;
+  // The source bit for the first bit of a destination byte (minus the
+  // position of that byte)
+  I32 BitDelta;
+} _BlitSpan;
+
+
+// The most planes a blit writes
+#define _GFXTK_BLIT_MAX_PLANES 8
+
+
+// Set the covered pixels of a chunky row to the colors that a byte of
+// each plane makes up
+static inline void _StoreChunkyByte(U8 *destination, U8 coverage, const U8 *planeBytes, U16 planeCount) {
+  for (U8 bit = 0x80; coverage; bit >>= 1, destination++) {
+    if (!(coverage & bit))
+      continue;
+    coverage &= ~bit;
+
+    U8 color = 0;
+    for (U16 plane = 0; plane < planeCount; plane++)
+      if (planeBytes[plane] & bit)
+	color |= 1 << plane;
+
+    *destination = color;
+  }
+}
+
+
+// Source and destination bits line up, so whole bytes can be copied. A
+// chunky destination has a single row.
+static inline void _BlitAlignedRow(const _BlitSpan *span,
+				   U8 **destinationRows,
+				   const U8 **sourceRows,
+				   U16 planeCount,
+				   const U8 *maskRow,
+				   bool chunky) {
+  const I32 byteDelta = span->BitDelta >> 3;
+
+  for (U16 byte = span->FirstByte; byte <= span->LastByte; byte++) {
+    U8 coverage = 0xff;
+    if (byte == span->FirstByte)
+      coverage &= span->MaskLeft;
+    if (byte == span->LastByte)
+      coverage &= span->MaskRight;
+    if (maskRow)
+      coverage &= maskRow[byte + byteDelta];
+
+    if (chunky) {
+      U8 planeBytes[_GFXTK_BLIT_MAX_PLANES];
+      for (U16 plane = 0; plane < planeCount; plane++)
+	planeBytes[plane] = sourceRows[plane] ? sourceRows[plane][byte + byteDelta] : 0;
+
+      _StoreChunkyByte(destinationRows[0] + (byte << 3), coverage, planeBytes, planeCount);
+      continue;
+    }
+
+    for (U16 plane = 0; plane < planeCount; plane++) {
+      U8 *destination = destinationRows[plane] + byte;
+      U8 source = sourceRows[plane] ? sourceRows[plane][byte + byteDelta] : 0;
+      *destination = (*destination & ~coverage) | (source & coverage);
+    }
   }
 }
 
 
+// Every destination byte is made of two neighbouring source bytes
+static inline void _BlitShiftedRow(const _BlitSpan *span,
+				   U8 **destinationRows,
+				   const U8 **sourceRows,
+				   U16 planeCount,
+				   const U8 *maskRow,
+				   U16 sourceBytesPerRow,
+				   bool chunky) {
+  for (U16 byte = span->FirstByte; byte <= span->LastByte; byte++) {
+    I32 bitOffset = (byte << 3) + span->BitDelta;
+
+    U8 coverage = 0xff;
+    if (byte == span->FirstByte)
+      coverage &= span->MaskLeft;
+    if (byte == span->LastByte)
+      coverage &= span->MaskRight;
+    if (maskRow)
+      coverage &= _ReadRowBits(maskRow, sourceBytesPerRow, bitOffset);
+
+    if (chunky) {
+      U8 planeBytes[_GFXTK_BLIT_MAX_PLANES];
+      for (U16 plane = 0; plane < planeCount; plane++)
+	planeBytes[plane] = sourceRows[plane]
+	  ? _ReadRowBits(sourceRows[plane], sourceBytesPerRow, bitOffset)
+	  : 0;
+
+      _StoreChunkyByte(destinationRows[0] + (byte << 3), coverage, planeBytes, planeCount);
+      continue;
+    }
+
+    for (U16 plane = 0; plane < planeCount; plane++) {
+      U8 *destination = destinationRows[plane] + byte;
+      U8 source = sourceRows[plane]
+	? _ReadRowBits(sourceRows[plane], sourceBytesPerRow, bitOffset)
+	: 0;
+      *destination = (*destination & ~coverage) | (source & coverage);
+    }
+  }
+}
+
+
+void _GfxTk_Blit(VgaConfig *config,
+		 Surface *surface,
+		 Rect2d source,
+		 Vector2d destination) {
+  if (!surface || !surface->Pixels)
+    return;
+  if (source.Position.X >= surface->Size.X || source.Position.Y >= surface->Size.Y)
+    return;
+
+  // Clip against the surface, then against the clip rect
+  U16 width = source.Size.X;
+  U16 height = source.Size.Y;
+  if (source.Position.X + width > surface->Size.X)
+    width = surface->Size.X - source.Position.X;
+  if (source.Position.Y + height > surface->Size.Y)
+    height = surface->Size.Y - source.Position.Y;
+
+  Rect2d area;
+  if (!_ClipArea(config, destination, (Vector2d) { width, height }, &area))
+    return;
+
+  source.Position.X += area.Position.X - destination.X;
+  source.Position.Y += area.Position.Y - destination.Y;
+  destination = area.Position;
+  width = area.Size.X;
+  height = area.Size.Y;
+
+  const U16 bytesPerRow = config->Resolution.X / 8;
+  const U32 bytesPerPlane = bytesPerRow * config->Resolution.Y;
+  const U32 sourceBytesPerPlane = surface->BytesPerRow * surface->Size.Y;
+  const U16 lastPixelX = destination.X + width - 1;
+
+  _BlitSpan span = {
+    .FirstByte = destination.X >> 3,
+    .LastByte = lastPixelX >> 3,
+    .MaskLeft = 0xff >> (destination.X & 7),
+    .MaskRight = 0xff << (7 - (lastPixelX & 7)),
+    .BitDelta = (I32)source.Position.X - destination.X
+  };
+
+  const bool aligned = (span.BitDelta & 7) == 0;
+  const bool chunky = config->Format == VgaChunky;
+  const U32 destinationBytesPerRow = chunky ? config->Resolution.X : bytesPerRow;
+
+  U16 planeCount = config->PlaneCount;
+  if (planeCount > _GFXTK_BLIT_MAX_PLANES)
+    planeCount = _GFXTK_BLIT_MAX_PLANES;
+
+  // Row pointers of all planes, moved along with the rows
+  U8 *destinationRows[_GFXTK_BLIT_MAX_PLANES];
+  const U8 *sourceRows[_GFXTK_BLIT_MAX_PLANES];
+  for (U16 plane = 0; plane < planeCount; plane++) {
+    destinationRows[plane] = (U8*)config->Backbuffer + (destination.Y * destinationBytesPerRow);
+    if (!chunky)
+      destinationRows[plane] += plane * bytesPerPlane;
+
+    // Planes the surface does not have are drawn as 0
+    sourceRows[plane] = plane < surface->PlaneCount
+      ? (U8*)surface->Pixels + (plane * sourceBytesPerPlane) + (source.Position.Y * surface->BytesPerRow)
+      : null;
+  }
+
+  const U8 *maskRow = surface->Mask
+    ? surface->Mask + (source.Position.Y * surface->BytesPerRow)
+    : null;
+
+  for (U16 row = 0; row < height; row++) {
+    if (aligned)
+      _BlitAlignedRow(&span, destinationRows, sourceRows, planeCount, maskRow, chunky);
+    else
+      _BlitShiftedRow(&span, destinationRows, sourceRows, planeCount, maskRow, surface->BytesPerRow, chunky);
+
+    for (U16 plane = 0; plane < planeCount; plane++) {
+      destinationRows[plane] += destinationBytesPerRow;
+      if (sourceRows[plane])
+	sourceRows[plane] += surface->BytesPerRow;
+    }
+
+    if (maskRow)
+      maskRow += surface->BytesPerRow;
+  }
+
+  Renderer.Invalidate(config, destination, (Vector2d) { width, height });
+}
+
+
 void _GfxTk_FillScreen(VgaConfig *config, U8 color) {
-  for (U16 line = 0; line < config->Resolution.Y; line++)
-    _FillRow(config, (Vector2d) { 0, line }, config->Resolution.X, color);
+  const Rect2d clip = _GetClip(config);
+
+  _FillRect(config, clip.Position, clip.Size.X, clip.Size.Y, color);
+
+  Renderer.Invalidate(config, clip.Position, clip.Size);
+}
+
+
+
+static inline bool _Rect2d_Touches(Rect2d a, Rect2d b) {
+  return a.Position.X <= b.Position.X + b.Size.X
+    && b.Position.X <= a.Position.X + a.Size.X
+    && a.Position.Y <= b.Position.Y + b.Size.Y
+    && b.Position.Y <= a.Position.Y + a.Size.Y;
+}
+
+
+static inline Rect2d _Rect2d_Union(Rect2d a, Rect2d b) {
+  U16 left   = a.Position.X < b.Position.X ? a.Position.X : b.Position.X;
+  U16 top    = a.Position.Y < b.Position.Y ? a.Position.Y : b.Position.Y;
+  U16 right  = a.Position.X + a.Size.X;
+  U16 bottom = a.Position.Y + a.Size.Y;
+
+  if (b.Position.X + b.Size.X > right)
+    right = b.Position.X + b.Size.X;
+  if (b.Position.Y + b.Size.Y > bottom)
+    bottom = b.Position.Y + b.Size.Y;
+
+  return (Rect2d) {
+    .Position = { left, top },
+    .Size = { right - left, bottom - top }
+  };
+}
+
+
+static inline U32 _Rect2d_GetArea(Rect2d rect) {
+  return (U32)rect.Size.X * rect.Size.Y;
+}
+
+
+static inline void _RemoveDirtyRect(VgaConfig *config, U16 index) {
+  config->DirtyRects[index] = config->DirtyRects[--config->DirtyCount];
+}
+
+
+
+void _GfxTk_Invalidate(VgaConfig *config,
+		       Vector2d position,
+		       Vector2d size) {
+  if (position.X >= config->Resolution.X || position.Y >= config->Resolution.Y)
+    return;
+
+  const U16 width = _GetWidth(config, position, size);
+  const U16 height = _GetHeight(config, position, size);
+  if (!width || !height)
+    return;
+
+  // The refresh copies whole bytes, so widen the region to byte boundaries
+  const U16 left = position.X & ~7;
+  const U16 right = (position.X + width + 7) & ~7;
+
+  Rect2d dirty = {
+    .Position = { left, position.Y },
+    .Size = { right - left, height }
+  };
+
+  for (;;) {
+    // Absorb every region the new one touches. The union can reach regions
+    // that did not touch before, so start over after each merge.
+    U16 index = 0;
+    while (index < config->DirtyCount) {
+      if (!_Rect2d_Touches(dirty, config->DirtyRects[index])) {
+	index++;
+	continue;
+      }
+
+      dirty = _Rect2d_Union(dirty, config->DirtyRects[index]);
+      _RemoveDirtyRect(config, index);
+      index = 0;
+    }
+
+    if (config->DirtyCount < VGA_DIRTY_RECT_COUNT) {
+      config->DirtyRects[config->DirtyCount++] = dirty;
+      return;
+    }
+
+    // All slots are taken; merge with the region that grows the least
+    U16 bestIndex = 0;
+    U32 bestGrowth = 0xffffffff;
+    for (index = 0; index < config->DirtyCount; index++) {
+      Rect2d candidate = config->DirtyRects[index];
+      U32 growth = _Rect2d_GetArea(_Rect2d_Union(dirty, candidate)) - _Rect2d_GetArea(candidate);
+
+      if (growth < bestGrowth) {
+	bestGrowth = growth;
+	bestIndex = index;
+      }
+    }
+
+    dirty = _Rect2d_Union(dirty, config->DirtyRects[bestIndex]);
+    _RemoveDirtyRect(config, bestIndex);
+  }
 }
 
 
@@ -349,106 +1327,443 @@ static void _Vram_Copy(void *dest, const void *src, U32 count) {
 }
 
 
+static inline bool _IsRegionPending(VgaConfig *config, Rect2d region) {
+  for (U16 index = 0; index < config->DirtyCount; index++)
+    if (_Rect2d_Touches(region, config->DirtyRects[index]))
+      return true;
+
+  return false;
+}
+
+
+static inline Rect2d _GetOverlayBounds(VgaOverlay *overlay) {
+  return (Rect2d) { overlay->Position, overlay->Sprite->Size };
+}
+
+
+// XOR the overlays that touch a region (or all of them, without one) onto
+// a page, which either draws them or takes them off again
+static void _XorOverlays(VgaConfig *config, U16 page, const Rect2d *region) {
+  for (U16 index = 0; index < config->OverlayCount; index++) {
+    VgaOverlay *overlay = config->Overlays[index];
+    if (region && !_Rect2d_Touches(_GetOverlayBounds(overlay), *region))
+      continue;
+
+    Vga.XorScreenSprite(config, page, overlay->Position, overlay->Sprite, overlay->Color);
+  }
+}
+
+
+// XOR the overlays that touch the dirty regions onto a page
+static void _XorPendingOverlays(VgaConfig *config, U16 page) {
+  for (U16 index = 0; index < config->OverlayCount; index++) {
+    VgaOverlay *overlay = config->Overlays[index];
+    if (!_IsRegionPending(config, _GetOverlayBounds(overlay)))
+      continue;
+
+    Vga.XorScreenSprite(config, page, overlay->Position, overlay->Sprite, overlay->Color);
+  }
+}
+
+
+Rect2d _GfxTk_ScrollRegion(VgaConfig *config,
+			   Vector2d position,
+			   Vector2d size,
+			   I16 rows) {
+  Rect2d area;
+  if (!_ClipArea(config, position, size, &area))
+    return (Rect2d) { .Position = position };
+
+  position = area.Position;
+  const U16 width = area.Size.X;
+  const U16 height = area.Size.Y;
+  const U16 distance = rows < 0 ? -rows : rows;
+
+  Rect2d exposed = {
+    .Position = position,
+    .Size = { width, height }
+  };
+
+  if (!distance || !width)
+    return (Rect2d) { .Position = position };
+  if (distance >= height)
+    return exposed;
+
+  const U16 bytesPerRow = config->Resolution.X / 8;
+  const U32 bytesPerPlane = bytesPerRow * config->Resolution.Y;
+  const U16 firstByteIndex = position.X >> 3;
+  const U16 byteCount = ((position.X + width + 7) >> 3) - firstByteIndex;
+
+  const U16 movedHeight = height - distance;
+  const U16 sourceY = rows > 0 ? position.Y + distance : position.Y;
+  const U16 destinationY = rows > 0 ? position.Y : position.Y + distance;
+
+  exposed.Size.Y = distance;
+  if (rows > 0)
+    exposed.Position.Y += movedHeight;
+
+  // Check before moving, the screen must show what the backbuffer shows
+  Rect2d region = {
+    .Position = { firstByteIndex << 3, position.Y },
+    .Size = { byteCount << 3, height }
+  };
+  bool screenIsCurrent = config->ScreenBuffer
+    && config->ScreenModel == VgaScreenPlanar
+    && config->PageCount < 2
+    && !_IsRegionPending(config, region);
+
+  // Copy the rows in an order that reads every row before overwriting it
+  if (config->Format == VgaChunky) {
+    U8 *buffer = (U8*)config->Backbuffer + (firstByteIndex << 3);
+
+    for (U16 index = 0; index < movedHeight; index++) {
+      U16 row = rows > 0 ? index : movedHeight - 1 - index;
+      _Vram_Copy(buffer + (destinationY + row) * config->Resolution.X,
+		 buffer + (sourceY + row) * config->Resolution.X,
+		 byteCount << 3);
+    }
+  } else
+    for (U8 plane = 0; plane < config->PlaneCount; plane++) {
+      U8 *buffer = (U8*)config->Backbuffer + (plane * bytesPerPlane) + firstByteIndex;
+
+      for (U16 index = 0; index < movedHeight; index++) {
+	U16 row = rows > 0 ? index : movedHeight - 1 - index;
+	_Vram_Copy(buffer + (destinationY + row) * bytesPerRow,
+		   buffer + (sourceY + row) * bytesPerRow,
+		   byteCount);
+      }
+    }
+
+  // Overlays must not be moved along
+  if (screenIsCurrent) {
+    _XorOverlays(config, 0, &region);
+    Vga.CopyScreenRect(config,
+		       (Vector2d) { region.Position.X, sourceY },
+		       (Vector2d) { region.Position.X, destinationY },
+		       (Vector2d) { region.Size.X, movedHeight });
+    _XorOverlays(config, 0, &region);
+  } else
+    Renderer.Invalidate(config, region.Position, region.Size);
+
+  return exposed;
+}
+
+
+// Eight neighbouring chunky pixels, read as two dwords
+typedef U32 __attribute__((may_alias)) ChunkySpan;
+
+
+// Gather the low nibbles of four chunky pixels (the first one ends up in
+// the highest nibble)
+static inline U32 _GatherNibbles(U32 pixels) {
+  pixels = __builtin_bswap32(pixels) & 0x0f0f0f0f;
+  pixels |= pixels >> 4;
+
+  return (pixels & 0xff) | ((pixels >> 8) & 0xff00);
+}
+
+
+// Swap the bits of a mask with the ones a distance above them
+static inline U32 _SwapBits(U32 value, U8 distance, U32 mask) {
+  U32 swapped = (value ^ (value >> distance)) & mask;
+
+  return value ^ swapped ^ (swapped << distance);
+}
+
+
+// Convert 8 chunky pixels to a byte of each of 4 planes (plane 0 in the
+// lowest byte). The nibbles of the pixels make up an 8x4 bit matrix,
+// which is transposed in four swaps.
+static inline U32 _ChunkyToPlanar8(const U8 *pixels) {
+  U32 bits = (_GatherNibbles(*(const ChunkySpan*)pixels) << 16)
+    | _GatherNibbles(*(const ChunkySpan*)(pixels + 4));
+
+  bits = _SwapBits(bits, 14, 0x0000cccc);
+  bits = _SwapBits(bits, 7, 0x00aa00aa);
+  bits = _SwapBits(bits, 2, 0x0c0c0c0c);
+
+  return _SwapBits(bits, 1, 0x22222222);
+}
+
+
+// Convert a row of chunky pixels to planes (a number of bytes apart)
+static inline void _ChunkyToPlanarRow(const U8 *pixels,
+				      U16 byteCount,
+				      U8 *planes,
+				      U32 bytesPerPlane,
+				      U16 planeCount) {
+  for (U16 byte = 0; byte < byteCount; byte++, pixels += 8) {
+    U32 bits = _ChunkyToPlanar8(pixels);
+
+    for (U16 plane = 0; plane < planeCount; plane++, bits >>= 8)
+      planes[(plane * bytesPerPlane) + byte] = (U8)bits;
+  }
+}
+
+
+void _GfxTk_ChunkyToPlanar(VgaConfig *config,
+			   Rect2d region,
+			   U8 *planes) {
+  if (!config || config->Format != VgaChunky || !planes)
+    return;
+  if (region.Position.X >= config->Resolution.X || region.Position.Y >= config->Resolution.Y)
+    return;
+
+  const U16 bytesPerRow = config->Resolution.X / 8;
+  const U32 bytesPerPlane = bytesPerRow * config->Resolution.Y;
+  const U16 planeCount = config->PlaneCount < 4 ? config->PlaneCount : 4;
+
+  const U16 width = _GetWidth(config, region.Position, region.Size);
+  const U16 height = _GetHeight(config, region.Position, region.Size);
+  const U16 firstByteIndex = region.Position.X >> 3;
+  const U16 byteCount = ((region.Position.X + width + 7) >> 3) - firstByteIndex;
+
+  for (U16 row = region.Position.Y; row < region.Position.Y + height; row++)
+    _ChunkyToPlanarRow((U8*)config->Backbuffer + (row * config->Resolution.X) + (firstByteIndex << 3),
+		       byteCount,
+		       planes + (row * bytesPerRow) + firstByteIndex,
+		       bytesPerPlane,
+		       planeCount);
+}
+
+
+// The planes of a strip of rows of a chunky backbuffer, which are
+// converted at once and then uploaded plane by plane
+#define _GFXTK_STRIP_SIZE 2048
+
+static U8 _PlanarStrip[4][_GFXTK_STRIP_SIZE];
+
+
+// Convert the dirty regions of a chunky backbuffer and copy them to a
+// screen page
+static void _UploadChunkyRects(VgaConfig *config, U8 *page) {
+  const U16 bytesPerRow = config->Resolution.X / 8;
+  const U16 planeCount = config->PlaneCount < 4 ? config->PlaneCount : 4;
+
+  for (U16 rectIndex = 0; rectIndex < config->DirtyCount; rectIndex++) {
+    Rect2d *rect = &config->DirtyRects[rectIndex];
+    const U16 firstByteIndex = rect->Position.X >> 3;
+    const U16 bytesPerSpan = rect->Size.X >> 3;
+    const U16 rowsPerStrip = _GFXTK_STRIP_SIZE / bytesPerSpan;
+
+    for (U16 stripRow = 0; stripRow < rect->Size.Y; stripRow += rowsPerStrip) {
+      const U16 y = rect->Position.Y + stripRow;
+      const U16 rowCount = rect->Size.Y - stripRow < rowsPerStrip
+	? rect->Size.Y - stripRow
+	: rowsPerStrip;
+
+      const U8 *pixels = (U8*)config->Backbuffer + (y * config->Resolution.X) + (firstByteIndex << 3);
+      for (U16 row = 0; row < rowCount; row++, pixels += config->Resolution.X)
+	_ChunkyToPlanarRow(pixels, bytesPerSpan, _PlanarStrip[0] + (row * bytesPerSpan), _GFXTK_STRIP_SIZE, planeCount);
+
+      for (U8 plane = 0; plane < planeCount; plane++) {
+	Vga.SetPlaneMask(1 << plane);
+
+	U32 offset = (y * bytesPerRow) + firstByteIndex;
+	for (U16 row = 0; row < rowCount; row++, offset += bytesPerRow)
+	  _Vram_Copy(page + offset, _PlanarStrip[plane] + (row * bytesPerSpan), bytesPerSpan);
+      }
+    }
+  }
+}
+
+
+// Copy the dirty regions of a chunky backbuffer to a linear screen,
+// where every byte is a pixel
+static void _UploadLinearRects(VgaConfig *config, U8 *page) {
+  const U16 bytesPerRow = config->Resolution.X;
+
+  for (U16 rectIndex = 0; rectIndex < config->DirtyCount; rectIndex++) {
+    Rect2d *rect = &config->DirtyRects[rectIndex];
+    U32 offset = (rect->Position.Y * bytesPerRow) + rect->Position.X;
+
+    if (rect->Size.X == bytesPerRow) {
+      _Vram_Copy(page + offset, (U8*)config->Backbuffer + offset, bytesPerRow * rect->Size.Y);
+      continue;
+    }
+
+    for (U16 row = 0; row < rect->Size.Y; row++, offset += bytesPerRow)
+      _Vram_Copy(page + offset, (U8*)config->Backbuffer + offset, rect->Size.X);
+  }
+}
+
+
+// Copy the dirty regions of a chunky backbuffer to an unchained screen,
+// where pixel x lives on plane x % 4 at byte x / 4
+static void _UploadUnchainedRects(VgaConfig *config, U8 *page) {
+  const U16 bytesPerRow = config->Resolution.X / 4;
+
+  for (U8 plane = 0; plane < 4; plane++) {
+    Vga.SetPlaneMask(1 << plane);
+
+    for (U16 rectIndex = 0; rectIndex < config->DirtyCount; rectIndex++) {
+      Rect2d *rect = &config->DirtyRects[rectIndex];
+      const U16 bytesPerSpan = rect->Size.X >> 2;
+
+      U32 offset = (rect->Position.Y * bytesPerRow) + (rect->Position.X >> 2);
+      const U8 *pixels = (U8*)config->Backbuffer
+	+ (rect->Position.Y * config->Resolution.X) + rect->Position.X + plane;
+
+      for (U16 row = 0; row < rect->Size.Y; row++, offset += bytesPerRow, pixels += config->Resolution.X) {
+	volatile U8 *destination = page + offset;
+	for (U16 index = 0; index < bytesPerSpan; index++)
+	  destination[index] = pixels[index << 2];
+      }
+    }
+  }
+}
+
+
+// Copy the dirty regions of the backbuffer to a screen page
+static void _UploadDirtyRects(VgaConfig *config, U8 *page) {
+  if (config->ScreenModel == VgaScreenLinear) {
+    _UploadLinearRects(config, page);
+    return;
+  }
+
+  if (config->ScreenModel == VgaScreenUnchained) {
+    _UploadUnchainedRects(config, page);
+    return;
+  }
+
+  if (config->Format == VgaChunky) {
+    _UploadChunkyRects(config, page);
+    return;
+  }
+
+  const U16 bytesPerRow = config->Resolution.X / 8;
+  const U32 bytesPerPlane = bytesPerRow * config->Resolution.Y;
+
+  for (U8 plane = 0; plane < config->PlaneCount; plane++) {
+    Vga.SetPlaneMask(1 << plane);
+    U8* buffer = config->Backbuffer + (bytesPerPlane * plane);
+
+    for (U16 rectIndex = 0; rectIndex < config->DirtyCount; rectIndex++) {
+      Rect2d *rect = &config->DirtyRects[rectIndex];
+      U32 offset = (rect->Position.Y * bytesPerRow) + (rect->Position.X >> 3);
+      U16 bytesPerSpan = rect->Size.X >> 3;
+
+      // Full width rows are contiguous in memory
+      if (bytesPerSpan == bytesPerRow) {
+	_Vram_Copy(page + offset, buffer + offset, bytesPerSpan * rect->Size.Y);
+	continue;
+      }
+
+      for (U16 row = 0; row < rect->Size.Y; row++, offset += bytesPerRow)
+	_Vram_Copy(page + offset, buffer + offset, bytesPerSpan);
+    }
+  }
+}
+
+
+// Bring the hidden page up to date and show it
+static void _RefreshFlipped(VgaConfig *config) {
+  const U32 pageSize = Vga.GetPageSize(config);
+  const U16 visiblePage = config->VisiblePage;
+  const U16 hiddenPage = visiblePage ^ 1;
+
+  // The hidden page also lacks what went to the other page last time
+  Rect2d changed[VGA_DIRTY_RECT_COUNT];
+  U16 changedCount = config->DirtyCount;
+  for (U16 index = 0; index < changedCount; index++)
+    changed[index] = config->DirtyRects[index];
+
+  for (U16 index = 0; index < config->PreviousDirtyCount; index++)
+    Renderer.Invalidate(config, config->PreviousDirtyRects[index].Position, config->PreviousDirtyRects[index].Size);
+
+  for (U16 index = 0; index < changedCount; index++)
+    config->PreviousDirtyRects[index] = changed[index];
+  config->PreviousDirtyCount = changedCount;
+
+  // No need to wait, the page is not displayed
+  Vga.SetBitmask(0xff);
+  _UploadDirtyRects(config, (U8*)config->ScreenBuffer + (hiddenPage * pageSize));
+
+  // Only the visible page holds the overlays
+  _XorOverlays(config, hiddenPage, null);
+
+  // The start address is latched at the beginning of the retrace
+  Vga.SetStartAddress(hiddenPage * pageSize);
+  Vga.PauseUntilVSync();
+  config->VisiblePage = hiddenPage;
+
+  _XorOverlays(config, visiblePage, null);
+}
+
+
 void _GfxTk_Refresh(VgaConfig *config) {
   if (!config->Backbuffer)
     return;
 
-  U32 bytesPerPlane = (config->Resolution.X / 8) * config->Resolution.Y;
-  
+  // Queued colors still reach the DAC when nothing else changed
+  if (!config->DirtyCount) {
+    if (Vga.HasQueuedPalette())
+      Vga.PauseUntilVSync();
+    return;
+  }
+
+  if (config->PageCount > 1) {
+    _RefreshFlipped(config);
+    config->DirtyCount = 0;
+    return;
+  }
+
   Vga.SetBitmask(0xff);
   Vga.PauseUntilVSync();
 
-  for (U8 plane = 0; plane < config->PlaneCount; plane++) {
-    Vga.SetPlaneMask(1 << plane);
-    U8* buffer = config->Backbuffer + (bytesPerPlane * plane);
-    _Vram_Copy(config->ScreenBuffer, buffer, bytesPerPlane);
-  }
-}
-
-
-
-
-#include "Include/Font_CompressionShort.h"
-#include "Include/Font_CompressionSquareShort.h"
-#include "Include/Font_CompressionSquareTall.h"
-#include "Include/Font_CompressionTall.h"
-#include "Include/Font_Envious.h"
-#include "Include/Font_EnviousBold.h"
-#include "Include/Font_EnviousItalic.h"
-#include "Include/Font_EnviousSerif.h"
-#include "Include/Font_EnviousSerifBold.h"
-#include "Include/Font_Forgotten.h"
-#include "Include/Font_ForgottenBold.h"
-#include "Include/Font_Pixie.h"
-#include "Include/Font_PixieBell.h"
-#include "Include/Font_PixieBellStretch.h"
-#include "Include/Font_PixieBold.h"
-#include "Include/Font_PixieDigital.h"
-#include "Include/Font_Widget.h"
-#include "Include/Font_WidgetBold.h"
-#include "Include/Font_ZXCourier.h"
-
-
-Bitmap8x8* _GfxTk_GetFontBitmap(FontId fontId) {
-  switch (fontId) {
-  case CompressionShort:
-    return (Bitmap8x8*)FONT_COMPRESSION_SHORT_BITMAP;
-
-  case CompressionSquareShort:
-    return (Bitmap8x8*)FONT_COMPRESSION_SQUARE_SHORT_BITMAP;
-
-  case CompressionSquareTall:
-    return (Bitmap8x8*)FONT_COMPRESSION_SQUARE_TALL_BITMAP;
-
-  case CompressionTall:
-    return (Bitmap8x8*)FONT_COMPRESSION_TALL_BITMAP;
-
-  case EnviousBold:
-    return (Bitmap8x8*)FONT_ENVIOUS_BOLD_BITMAP;
-
-  case Envious:
-    return (Bitmap8x8*)FONT_ENVIOUS_BITMAP;
-
-  case EnviousItalic:
-    return (Bitmap8x8*)FONT_ENVIOUS_ITALIC_BITMAP;
-
-  case EnviousSerif:
-    return (Bitmap8x8*)FONT_ENVIOUS_SERIF_BITMAP;
-    
-  case EnviousSerifBold:
-    return (Bitmap8x8*)FONT_ENVIOUS_SERIF_BOLD_BITMAP;
-
-  case Forgotten:
-    return (Bitmap8x8*)FONT_FORGOTTEN_BITMAP;
-
-  case ForgottenBold:
-    return (Bitmap8x8*)FONT_FORGOTTEN_BOLD_BITMAP;
-
-  case Pixie:
-    return (Bitmap8x8*)FONT_PIXIE_BITMAP;
-    
-  case PixieBell:
-    return (Bitmap8x8*)FONT_PIXIE_BELL_BITMAP;
-    
-  case PixieBellStretch:
-    return (Bitmap8x8*)FONT_PIXIE_BELL_STRETCH_BITMAP;
-    
-  case PixieBold:
-    return (Bitmap8x8*)FONT_PIXIE_BOLD_BITMAP;
-    
-  case PixieDigital:
-    return (Bitmap8x8*)FONT_PIXIE_DIGITAL_BITMAP;
-    
-  case Widget:
-    return (Bitmap8x8*)FONT_WIDGET_BITMAP;
-    
-  case WidgetBold:
-    return (Bitmap8x8*)FONT_WIDGET_BOLD_BITMAP;
-    
-  case ZxCourier:
-    return (Bitmap8x8*)FONT_ZX_COURIER_BITMAP;
-
-  default:
-    return null;
+  // Take the overlays off the uploaded regions, so they can be drawn
+  // on top again
+  _XorPendingOverlays(config, 0);
+  _UploadDirtyRects(config, config->ScreenBuffer);
+  _XorPendingOverlays(config, 0);
+
+  config->DirtyCount = 0;
+}
+
+
+
+// ----------------------------------------------------------------------
+// Overlays
+// ----------------------------------------------------------------------
+
+
+bool _GfxTk_ShowOverlay(VgaConfig *config, VgaOverlay *overlay) {
+  if (overlay->Visible)
+    return true;
+  if (!config->ScreenBuffer || !overlay->Sprite || config->OverlayCount >= VGA_OVERLAY_COUNT)
+    return false;
+
+  config->Overlays[config->OverlayCount++] = overlay;
+  Vga.XorScreenSprite(config, config->VisiblePage, overlay->Position, overlay->Sprite, overlay->Color);
+  overlay->Visible = true;
+
+  return true;
+}
+
+
+void _GfxTk_HideOverlay(VgaConfig *config, VgaOverlay *overlay) {
+  for (U16 index = 0; index < config->OverlayCount; index++) {
+    if (config->Overlays[index] != overlay)
+      continue;
+
+    // XOR a second time to restore the screen
+    Vga.XorScreenSprite(config, config->VisiblePage, overlay->Position, overlay->Sprite, overlay->Color);
+    config->Overlays[index] = config->Overlays[--config->OverlayCount];
+    overlay->Visible = false;
+    return;
   }
 }
+
+
+void _GfxTk_MoveOverlay(VgaConfig *config,
+			VgaOverlay *overlay,
+			Vector2d position) {
+  if (!overlay->Visible) {
+    overlay->Position = position;
+    return;
+  }
+
+  Vga.XorScreenSprite(config, config->VisiblePage, overlay->Position, overlay->Sprite, overlay->Color);
+  overlay->Position = position;
+  Vga.XorScreenSprite(config, config->VisiblePage, position, overlay->Sprite, overlay->Color);
+}
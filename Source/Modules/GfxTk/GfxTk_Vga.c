@@ -29,6 +29,8 @@
 
 #include "Include/GfxTk.h"
 
+import(Renderer);
+
 
 #define _GFXTK_PORT_VGASTATUS 0x3da
 
@@ -62,12 +64,56 @@ void _GfxTk_DisableOutput(void) {
 
 #define _GFXTK_PORT_GRAPHICS_DATA 0x3cf
 
+#define _GFXTK_INDEX_SETRESET 0x00
+
+#define _GFXTK_INDEX_ENABLE_SETRESET 0x01
+
+#define _GFXTK_INDEX_DATAROTATE 0x03
+
+#define _GFXTK_INDEX_READMAP 0x04
+
+#define _GFXTK_INDEX_MODE 0x05
+
 #define _GFXTK_INDEX_BITMASK 0x08
 
 
+static inline void _WriteGraphicsRegister(U8 index, U8 value) {
+  PortWriteByte(_GFXTK_PORT_GRAPHICS_INDEX, index);
+  PortWriteByte(_GFXTK_PORT_GRAPHICS_DATA, value);
+}
+
+
+static inline U8 _ReadGraphicsRegister(U8 index) {
+  PortWriteByte(_GFXTK_PORT_GRAPHICS_INDEX, index);
+  return PortReadByte(_GFXTK_PORT_GRAPHICS_DATA);
+}
+
+
 void _GfxTk_SetBitmask(U8 bitmask) {
-  PortWriteByte(_GFXTK_PORT_GRAPHICS_INDEX, _GFXTK_INDEX_BITMASK);
-  PortWriteByte(_GFXTK_PORT_GRAPHICS_DATA, bitmask);
+  _WriteGraphicsRegister(_GFXTK_INDEX_BITMASK, bitmask);
+}
+
+
+void _GfxTk_SetWriteMode(U8 mode) {
+  // Keep the read mode and shift settings
+  U8 current = _ReadGraphicsRegister(_GFXTK_INDEX_MODE);
+  _WriteGraphicsRegister(_GFXTK_INDEX_MODE, (current & ~0x03) | (mode & 0x03));
+}
+
+
+void _GfxTk_SetSetReset(U8 color) {
+  _WriteGraphicsRegister(_GFXTK_INDEX_SETRESET, color & 0x0f);
+}
+
+
+void _GfxTk_EnableSetReset(U8 planeMask) {
+  _WriteGraphicsRegister(_GFXTK_INDEX_ENABLE_SETRESET, planeMask & 0x0f);
+}
+
+
+void _GfxTk_SetLogicOperation(VgaLogicOperation operation) {
+  // Bits 3-4 select the operation, the rotate count stays 0
+  _WriteGraphicsRegister(_GFXTK_INDEX_DATAROTATE, (operation & 0x03) << 3);
 }
 
 
@@ -85,9 +131,289 @@ void _GfxTk_SetPlaneMask(U8 planeMask) {
 }
 
 
+static void _UploadQueuedPalette(void);
+
+
 void _GfxTk_PauseUntilVSync(void) {
   while (!(PortReadByte(_GFXTK_PORT_VGASTATUS) & 0x08))
     ;
+
+  // The retrace has just begun, the DAC can be changed without tearing
+  _UploadQueuedPalette();
+}
+
+
+
+#define _GFXTK_PORT_CRTC_INDEX 0x3d4
+
+#define _GFXTK_PORT_CRTC_DATA 0x3d5
+
+#define _GFXTK_INDEX_OVERFLOW 0x07
+
+#define _GFXTK_INDEX_MAXSCANLINE 0x09
+
+#define _GFXTK_INDEX_STARTADDRESS_HIGH 0x0c
+
+#define _GFXTK_INDEX_STARTADDRESS_LOW 0x0d
+
+#define _GFXTK_INDEX_LINECOMPARE 0x18
+
+
+static inline void _WriteCrtcRegister(U8 index, U8 value) {
+  PortWriteByte(_GFXTK_PORT_CRTC_INDEX, index);
+  PortWriteByte(_GFXTK_PORT_CRTC_DATA, value);
+}
+
+
+static inline U8 _ReadCrtcRegister(U8 index) {
+  PortWriteByte(_GFXTK_PORT_CRTC_INDEX, index);
+  return PortReadByte(_GFXTK_PORT_CRTC_DATA);
+}
+
+
+void _GfxTk_SetStartAddress(U16 offset) {
+  _WriteCrtcRegister(_GFXTK_INDEX_STARTADDRESS_HIGH, offset >> 8);
+  _WriteCrtcRegister(_GFXTK_INDEX_STARTADDRESS_LOW, offset & 0xff);
+}
+
+
+void _GfxTk_SetLineCompare(U16 line) {
+  if (line > 0x3ff)
+    line = 0x3ff;
+
+  // Bits 0-7 have their own register, bit 8 is in the overflow register
+  // (bit 4) and bit 9 in the maximum scanline register (bit 6)
+  U8 overflow = _ReadCrtcRegister(_GFXTK_INDEX_OVERFLOW) & ~0x10;
+  U8 maxScanline = _ReadCrtcRegister(_GFXTK_INDEX_MAXSCANLINE) & ~0x40;
+
+  _WriteCrtcRegister(_GFXTK_INDEX_LINECOMPARE, line & 0xff);
+  _WriteCrtcRegister(_GFXTK_INDEX_OVERFLOW, overflow | ((line >> 4) & 0x10));
+  _WriteCrtcRegister(_GFXTK_INDEX_MAXSCANLINE, maxScanline | ((line >> 3) & 0x40));
+}
+
+
+
+// ----------------------------------------------------------------------
+// Video modes
+// ----------------------------------------------------------------------
+
+
+#define _GFXTK_PORT_MISC_OUTPUT 0x3c2
+
+#define _GFXTK_INDEX_HORIZONTAL_BLANK_END 0x03
+
+#define _GFXTK_INDEX_VERTICAL_RETRACE_END 0x11
+
+#define _GFXTK_INDEX_SEQUENCER_RESET 0x00
+
+
+// The register values of a video mode
+typedef struct {
+  U8 MiscOutput;
+  U8 Sequencer[5];
+  U8 Crtc[25];
+  U8 Graphics[9];
+  U8 Attribute[21];
+} _VgaRegisters;
+
+
+typedef struct {
+  Vector2d Resolution;
+  U16 PlaneCount;
+  VgaScreenModel ScreenModel;
+  const _VgaRegisters *Registers;
+} _VgaModeInfo;
+
+
+static const _VgaRegisters _Mode12hRegisters = {
+  .MiscOutput = 0xe3,
+  .Sequencer = { 0x03, 0x01, 0x08, 0x00, 0x06 },
+  .Crtc = {
+    0x5f, 0x4f, 0x50, 0x82, 0x54, 0x80, 0x0b, 0x3e,
+    0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xea, 0x0c, 0xdf, 0x28, 0x00, 0xe7, 0x04, 0xe3,
+    0xff
+  },
+  .Graphics = { 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x05, 0x0f, 0xff },
+  .Attribute = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x14, 0x07,
+    0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f,
+    0x01, 0x00, 0x0f, 0x00, 0x00
+  }
+};
+
+
+static const _VgaRegisters _Mode13hRegisters = {
+  .MiscOutput = 0x63,
+  .Sequencer = { 0x03, 0x01, 0x0f, 0x00, 0x0e },
+  .Crtc = {
+    0x5f, 0x4f, 0x50, 0x82, 0x54, 0x80, 0xbf, 0x1f,
+    0x00, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x9c, 0x0e, 0x8f, 0x28, 0x40, 0x96, 0xb9, 0xa3,
+    0xff
+  },
+  .Graphics = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x05, 0x0f, 0xff },
+  .Attribute = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x41, 0x00, 0x0f, 0x00, 0x00
+  }
+};
+
+
+// Mode 13h with chain 4 turned off (so all of the 256 KiB are usable),
+// byte addressing and the 480 line timing, with every line doubled
+static const _VgaRegisters _ModeXRegisters = {
+  .MiscOutput = 0xe3,
+  .Sequencer = { 0x03, 0x01, 0x0f, 0x00, 0x06 },
+  .Crtc = {
+    0x5f, 0x4f, 0x50, 0x82, 0x54, 0x80, 0x0d, 0x3e,
+    0x00, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xea, 0x2c, 0xdf, 0x28, 0x00, 0xe7, 0x06, 0xe3,
+    0xff
+  },
+  .Graphics = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x05, 0x0f, 0xff },
+  .Attribute = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x41, 0x00, 0x0f, 0x00, 0x00
+  }
+};
+
+
+static const _VgaModeInfo _Modes[] = {
+  [VgaMode12h] = { { 640, 480 }, 4, VgaScreenPlanar, &_Mode12hRegisters },
+  [VgaMode13h] = { { 320, 200 }, 8, VgaScreenLinear, &_Mode13hRegisters },
+  [VgaModeX] = { { 320, 240 }, 8, VgaScreenUnchained, &_ModeXRegisters }
+};
+
+
+static void _WriteRegisters(const _VgaRegisters *registers) {
+  // Hold the sequencer in synchronous reset while the clocks change
+  PortWriteByte(_GFXTK_PORT_SEQUENCER_INDEX, _GFXTK_INDEX_SEQUENCER_RESET);
+  PortWriteByte(_GFXTK_PORT_SEQUENCER_DATA, 0x01);
+
+  PortWriteByte(_GFXTK_PORT_MISC_OUTPUT, registers->MiscOutput);
+
+  for (U8 index = 1; index < sizeof(registers->Sequencer); index++) {
+    PortWriteByte(_GFXTK_PORT_SEQUENCER_INDEX, index);
+    PortWriteByte(_GFXTK_PORT_SEQUENCER_DATA, registers->Sequencer[index]);
+  }
+
+  // Let the sequencer run again
+  PortWriteByte(_GFXTK_PORT_SEQUENCER_INDEX, _GFXTK_INDEX_SEQUENCER_RESET);
+  PortWriteByte(_GFXTK_PORT_SEQUENCER_DATA, registers->Sequencer[_GFXTK_INDEX_SEQUENCER_RESET]);
+
+  // The timing registers (0-7) are write protected by bit 7 of the
+  // vertical retrace end; unlock them and keep them unlocked
+  _WriteCrtcRegister(_GFXTK_INDEX_VERTICAL_RETRACE_END,
+		     _ReadCrtcRegister(_GFXTK_INDEX_VERTICAL_RETRACE_END) & ~0x80);
+
+  for (U8 index = 0; index < sizeof(registers->Crtc); index++) {
+    U8 value = registers->Crtc[index];
+    if (index == _GFXTK_INDEX_HORIZONTAL_BLANK_END)
+      value |= 0x80;
+    if (index == _GFXTK_INDEX_VERTICAL_RETRACE_END)
+      value &= ~0x80;
+
+    _WriteCrtcRegister(index, value);
+  }
+
+  for (U8 index = 0; index < sizeof(registers->Graphics); index++)
+    _WriteGraphicsRegister(index, registers->Graphics[index]);
+
+  for (U8 index = 0; index < sizeof(registers->Attribute); index++) {
+    // Switch to index mode
+    PortReadByte(_GFXTK_PORT_VGASTATUS);
+    PortWriteByte(_GFXTK_PORT_ATTRIBUTE_INDEX, index);
+    PortWriteByte(_GFXTK_PORT_ATTRIBUTE_INDEX, registers->Attribute[index]);
+  }
+
+  // Set video enable bit
+  PortReadByte(_GFXTK_PORT_VGASTATUS);
+  PortWriteByte(_GFXTK_PORT_ATTRIBUTE_INDEX, 0x20);
+}
+
+
+bool _GfxTk_SetMode(VgaConfig *config, VgaMode mode) {
+  if (!config || mode >= sizeof(_Modes) / sizeof(_Modes[0]))
+    return false;
+
+  const _VgaModeInfo *info = &_Modes[mode];
+  _WriteRegisters(info->Registers);
+
+  config->Resolution = info->Resolution;
+  config->PlaneCount = info->PlaneCount;
+  config->ScreenModel = info->ScreenModel;
+  config->ScreenBuffer = (void*)0xa0000;
+
+  // Pixels are bytes on screen, so they are bytes in the backbuffer too
+  if (info->ScreenModel != VgaScreenPlanar)
+    config->Format = VgaChunky;
+
+  config->PageCount = 1;
+  config->VisiblePage = 0;
+  config->PreviousDirtyCount = 0;
+  config->DirtyCount = 0;
+  config->ClipDepth = 0;
+  _GfxTk_SetStartAddress(0);
+
+  // The screen contents are gone, including the overlays
+  for (U16 index = 0; index < config->OverlayCount; index++)
+    config->Overlays[index]->Visible = false;
+  config->OverlayCount = 0;
+
+  Renderer.Invalidate(config, (Vector2d) { 0, 0 }, config->Resolution);
+  return true;
+}
+
+
+U32 _GfxTk_GetPageSize(VgaConfig *config) {
+  switch (config->ScreenModel) {
+  case VgaScreenLinear:
+    return config->Resolution.X * config->Resolution.Y;
+
+  case VgaScreenUnchained:
+    return (config->Resolution.X / 4) * config->Resolution.Y;
+
+  default:
+    return (config->Resolution.X / 8) * config->Resolution.Y;
+  }
+}
+
+
+
+bool _GfxTk_EnablePageFlipping(VgaConfig *config) {
+  // Both pages have to fit into the 64 KiB of a plane
+  if (!config->ScreenBuffer || _GfxTk_GetPageSize(config) * 2 > 0x10000)
+    return false;
+
+  config->PageCount = 2;
+  config->VisiblePage = 0;
+  _GfxTk_SetStartAddress(0);
+
+  // Both pages need the whole picture once
+  Rect2d screen = {
+    .Position = { 0, 0 },
+    .Size = config->Resolution
+  };
+
+  Renderer.Invalidate(config, screen.Position, screen.Size);
+  config->PreviousDirtyRects[0] = screen;
+  config->PreviousDirtyCount = 1;
+
+  return true;
+}
+
+
+void _GfxTk_DisablePageFlipping(VgaConfig *config) {
+  config->PageCount = 1;
+  config->VisiblePage = 0;
+  config->PreviousDirtyCount = 0;
+  _GfxTk_SetStartAddress(0);
+
+  // The first page may be behind
+  Renderer.Invalidate(config, (Vector2d) { 0, 0 }, config->Resolution);
 }
 
 
@@ -110,6 +436,102 @@ void _GfxTk_SetPalette(U8 index, Rgb18 color) {
 }
 
 
+// Palette colors as the DAC takes them, 3 bytes (red, green, blue) each
+static U8 _PaletteData[256 * 3];
+
+// Colors waiting for the next vertical retrace
+static U8 _QueuedPalette[256 * 3];
+// One bit per queued entry; entries in between keep their DAC color
+static U32 _QueuedEntries[256 / 32];
+// The range of entries that may be queued (empty if start equals end)
+static U16 _QueuedStart;
+static U16 _QueuedEnd;
+
+
+static inline bool _IsEntryQueued(U16 index) {
+  return _QueuedEntries[index >> 5] & (1u << (index & 31));
+}
+
+
+// Trim colors to 6 bit and store them as DAC data
+static inline void _PackColors(U8 *data, const Rgb18 *colors, U16 count) {
+  for (U16 index = 0; index < count; index++) {
+    *data++ = colors[index].Red % 64;
+    *data++ = colors[index].Green % 64;
+    *data++ = colors[index].Blue % 64;
+  }
+}
+
+
+static inline void _WritePaletteData(U8 start, const U8 *data, U16 count) {
+  PortWriteByte(_GFXTK_PORT_DAC_INDEX, start);
+  // The DAC index advances after every third data byte
+  PortWriteBytes(_GFXTK_PORT_DAC_DATA, data, count * 3);
+}
+
+
+void _GfxTk_SetPaletteRange(U8 start, U16 count, const Rgb18 *colors) {
+  if (count > 256 - start)
+    count = 256 - start;
+  if (!count)
+    return;
+
+  _PackColors(_PaletteData, colors, count);
+  _WritePaletteData(start, _PaletteData, count);
+}
+
+
+void _GfxTk_QueuePaletteRange(U8 start, U16 count, const Rgb18 *colors) {
+  if (count > 256 - start)
+    count = 256 - start;
+  if (!count)
+    return;
+
+  _PackColors(_QueuedPalette + (start * 3), colors, count);
+  for (U16 index = start; index < start + count; index++)
+    _QueuedEntries[index >> 5] |= 1u << (index & 31);
+
+  if (_QueuedStart == _QueuedEnd) {
+    _QueuedStart = start;
+    _QueuedEnd = start + count;
+    return;
+  }
+
+  if (start < _QueuedStart)
+    _QueuedStart = start;
+  if (start + count > _QueuedEnd)
+    _QueuedEnd = start + count;
+}
+
+
+bool _GfxTk_HasQueuedPalette(void) {
+  return _QueuedStart != _QueuedEnd;
+}
+
+
+// Upload every run of queued entries with its own burst
+static void _UploadQueuedPalette(void) {
+  U16 index = _QueuedStart;
+
+  while (index < _QueuedEnd) {
+    if (!_IsEntryQueued(index)) {
+      index++;
+      continue;
+    }
+
+    U16 runStart = index;
+    while (index < _QueuedEnd && _IsEntryQueued(index))
+      index++;
+
+    _WritePaletteData(runStart, _QueuedPalette + (runStart * 3), index - runStart);
+  }
+
+  for (U16 word = 0; word < sizeof(_QueuedEntries) / sizeof(_QueuedEntries[0]); word++)
+    _QueuedEntries[word] = 0;
+  _QueuedStart = _QueuedEnd = 0;
+}
+
+
 void _GfxTk_UseColor(U8 index, U8 paletteIndex) {
   // Switch to index mode
   PortReadByte(_GFXTK_PORT_VGASTATUS);
@@ -124,5 +546,330 @@ void _GfxTk_UseColor(U8 index, U8 paletteIndex) {
 }
 
 
+void _GfxTk_UseColorRange(U8 index, U8 count, const U8 *paletteIndices) {
+  // Switch to index mode once, the flip-flop toggles with every write
+  PortReadByte(_GFXTK_PORT_VGASTATUS);
+
+  for (U8 offset = 0; offset < count && index + offset < 16; offset++) {
+    PortWriteByte(_GFXTK_PORT_ATTRIBUTE_INDEX, index + offset);
+    PortWriteByte(_GFXTK_PORT_ATTRIBUTE_INDEX, paletteIndices[offset]);
+  }
+
+  // Set video enable bit
+  PortReadByte(_GFXTK_PORT_VGASTATUS);
+  PortWriteByte(_GFXTK_PORT_ATTRIBUTE_INDEX, 0x20);
+}
+
+
+
+// ----------------------------------------------------------------------
+// Direct screen access
+// ----------------------------------------------------------------------
+
+
+// Write a byte value to screen memory, a dword at a time
+static inline void _Vram_Fill(volatile U8 *destination, U8 value, U32 count) {
+  U32 dwords  = count / 4;
+  U32 bytes   = count % 4;
+  U32 pattern = value * 0x01010101;
+
+  __asm__ __volatile__ (
+			"cld\n\t"
+			"rep stosl\n\t"
+			"movl %3, %%ecx\n\t"
+			"rep stosb\n\t"
+			: "+D"(destination), "+c"(dwords)
+			: "a"(pattern), "r"(bytes)
+			: "memory"
+			);
+}
+
+
+// Fill one byte column of a rect, keeping the pixels outside the mask
+static inline void _FillScreenColumn(volatile U8 *destination,
+				     U16 height,
+				     U16 bytesPerRow,
+				     U8 mask,
+				     U8 color) {
+  _GfxTk_SetBitmask(mask);
+
+  for (U16 row = 0; row < height; row++, destination += bytesPerRow) {
+    // Load the latches, they provide the bits outside the mask
+    (void)*destination;
+    *destination = color;
+  }
+}
+
+
+void _GfxTk_FillScreenRect(VgaConfig *config,
+			   Vector2d position,
+			   Vector2d size,
+			   U8 color) {
+  if (config->ScreenModel != VgaScreenPlanar)
+    return;
+  if (position.X >= config->Resolution.X || position.Y >= config->Resolution.Y)
+    return;
+
+  const U16 width = (position.X + size.X > config->Resolution.X)
+    ? config->Resolution.X - position.X
+    : size.X;
+  const U16 height = (position.Y + size.Y > config->Resolution.Y)
+    ? config->Resolution.Y - position.Y
+    : size.Y;
+  if (!width || !height)
+    return;
+
+  const U16	bytesPerRow    = config->Resolution.X / 8;
+  const U16	firstByteIndex = position.X >> 3;
+  const U16	lastPixelX     = position.X + width - 1;
+  const U16	lastByteIndex  = lastPixelX >> 3;
+
+  U8	maskLeft  = 0xff >> (position.X & 7);
+  U8	maskRight = 0xff << (7 - (lastPixelX & 7));
+  U16	middleStart = firstByteIndex;
+  U16	middleEnd   = lastByteIndex + 1;
+
+  if (firstByteIndex == lastByteIndex) {
+    maskLeft &= maskRight;
+    maskRight = 0xff;
+  }
+
+  if (maskLeft != 0xff)
+    middleStart++;
+  else
+    maskLeft = 0;
+
+  if (maskRight != 0xff)
+    middleEnd--;
+  else
+    maskRight = 0;
+
+  volatile U8 *rowAddress = (volatile U8*)config->ScreenBuffer + (position.Y * bytesPerRow);
+
+  // Every byte written sets 8 pixels in all planes to the color
+  _GfxTk_SetPlaneMask(0x0f);
+  _GfxTk_SetLogicOperation(VgaReplace);
+  _GfxTk_SetWriteMode(2);
+
+  if (maskLeft)
+    _FillScreenColumn(rowAddress + firstByteIndex, height, bytesPerRow, maskLeft, color);
+  if (maskRight)
+    _FillScreenColumn(rowAddress + lastByteIndex, height, bytesPerRow, maskRight, color);
+
+  _GfxTk_SetBitmask(0xff);
+  if (middleEnd > middleStart) {
+    const U16 middleCount = middleEnd - middleStart;
+
+    // Full width rows are one contiguous span
+    if (middleCount == bytesPerRow)
+      _Vram_Fill(rowAddress, color, bytesPerRow * height);
+    else
+      for (U16 row = 0; row < height; row++, rowAddress += bytesPerRow)
+	_Vram_Fill(rowAddress + middleStart, color, middleCount);
+  }
+
+  _GfxTk_SetWriteMode(0);
+}
 
 
+// Copy a span of screen bytes through the latches (write mode 1)
+static inline void _CopyScreenSpan(volatile U8 *destination,
+				   volatile U8 *source,
+				   U16 count,
+				   bool backward) {
+  if (backward) {
+    while (count--)
+      destination[count] = source[count];
+    return;
+  }
+
+  for (U16 index = 0; index < count; index++)
+    destination[index] = source[index];
+}
+
+
+void _GfxTk_CopyScreenRect(VgaConfig *config,
+			   Vector2d source,
+			   Vector2d destination,
+			   Vector2d size) {
+  if (config->ScreenModel != VgaScreenPlanar)
+    return;
+
+  const U16 bytesPerRow = config->Resolution.X / 8;
+
+  const U16 sourceByte = source.X >> 3;
+  const U16 destinationByte = destination.X >> 3;
+  U16 byteCount = (size.X + 7) >> 3;
+  U16 height = size.Y;
+
+  if (sourceByte >= bytesPerRow || destinationByte >= bytesPerRow
+      || source.Y >= config->Resolution.Y || destination.Y >= config->Resolution.Y)
+    return;
+
+  // Clip against the screen for both locations
+  if (sourceByte + byteCount > bytesPerRow)
+    byteCount = bytesPerRow - sourceByte;
+  if (destinationByte + byteCount > bytesPerRow)
+    byteCount = bytesPerRow - destinationByte;
+  if (source.Y + height > config->Resolution.Y)
+    height = config->Resolution.Y - source.Y;
+  if (destination.Y + height > config->Resolution.Y)
+    height = config->Resolution.Y - destination.Y;
+
+  if (!byteCount || !height)
+    return;
+
+  volatile U8 *screen = (volatile U8*)config->ScreenBuffer;
+  volatile U8 *sourceRow = screen + (source.Y * bytesPerRow) + sourceByte;
+  volatile U8 *destinationRow = screen + (destination.Y * bytesPerRow) + destinationByte;
+
+  // Walk against the direction of the move, so overlapping source bytes
+  // are read before they are overwritten
+  const bool bottomUp = destination.Y > source.Y;
+  const bool backward = destination.Y == source.Y && destinationByte > sourceByte;
+  I32 stride = bytesPerRow;
+
+  if (bottomUp) {
+    sourceRow += (height - 1) * bytesPerRow;
+    destinationRow += (height - 1) * bytesPerRow;
+    stride = -stride;
+  }
+
+  // Every byte read loads all planes into the latches, every write
+  // stores them again
+  _GfxTk_SetPlaneMask(0x0f);
+  _GfxTk_SetWriteMode(1);
+
+  for (U16 row = 0; row < height; row++, sourceRow += stride, destinationRow += stride)
+    _CopyScreenSpan(destinationRow, sourceRow, byteCount, backward);
+
+  _GfxTk_SetWriteMode(0);
+}
+
+
+// Get the byte of a sprite row that holds 8 pixels, without the padding
+// bits behind the last pixel
+static inline U8 _GetSpriteByte(const VgaSprite *sprite, const U8 *row, U16 index) {
+  const U16 bytesPerRow = (sprite->Size.X + 7) >> 3;
+  if (index >= bytesPerRow)
+    return 0;
+
+  if (index == bytesPerRow - 1 && (sprite->Size.X & 7))
+    return row[index] & (0xff << (8 - (sprite->Size.X & 7)));
+
+  return row[index];
+}
+
+
+static void _XorPlanarSprite(VgaConfig *config,
+			     volatile U8 *page,
+			     Vector2d position,
+			     const VgaSprite *sprite,
+			     U16 height,
+			     U8 color) {
+  const U16 bytesPerRow = config->Resolution.X / 8;
+  const U16 bytesPerSpriteRow = (sprite->Size.X + 7) >> 3;
+  const U16 firstByteIndex = position.X >> 3;
+  const U8 shift = position.X & 7;
+
+  // Every write puts the color through XOR with the latches, limited
+  // to the pixels of the sprite by the bitmask
+  _GfxTk_SetPlaneMask(0x0f);
+  _GfxTk_SetWriteMode(0);
+  _GfxTk_SetSetReset(color);
+  _GfxTk_EnableSetReset(0x0f);
+  _GfxTk_SetLogicOperation(VgaXor);
+
+  volatile U8 *row = page + (position.Y * bytesPerRow) + firstByteIndex;
+  const U8 *mask = sprite->Mask;
+
+  for (U16 y = 0; y < height; y++, row += bytesPerRow, mask += bytesPerSpriteRow) {
+    // An unaligned sprite byte spreads over two screen bytes
+    U8 carry = 0;
+
+    for (U16 index = 0; index <= bytesPerSpriteRow && firstByteIndex + index < bytesPerRow; index++) {
+      U8 bits = _GetSpriteByte(sprite, mask, index);
+      U8 bitmask = carry | (bits >> shift);
+      carry = shift ? (U8)(bits << (8 - shift)) : 0;
+      if (!bitmask)
+	continue;
+
+      _GfxTk_SetBitmask(bitmask);
+      (void)row[index];
+      row[index] = 0xff;
+    }
+  }
+
+  _GfxTk_SetLogicOperation(VgaReplace);
+  _GfxTk_EnableSetReset(0);
+  _GfxTk_SetBitmask(0xff);
+}
+
+
+// XOR every step-th pixel of a sprite, starting at a column, on a screen
+// with one byte per pixel (every 4th pixel per plane for unchained ones)
+static void _XorBytePixels(VgaConfig *config,
+			   volatile U8 *page,
+			   Vector2d position,
+			   const VgaSprite *sprite,
+			   U16 height,
+			   U8 color,
+			   U16 firstColumn,
+			   U8 columnShift) {
+  const U16 bytesPerRow = config->Resolution.X >> columnShift;
+  const U16 bytesPerSpriteRow = (sprite->Size.X + 7) >> 3;
+  const U16 step = 1 << columnShift;
+
+  volatile U8 *row = page + (position.Y * bytesPerRow);
+  const U8 *mask = sprite->Mask;
+
+  for (U16 y = 0; y < height; y++, row += bytesPerRow, mask += bytesPerSpriteRow)
+    for (U16 x = firstColumn; x < sprite->Size.X; x += step) {
+      U16 screenX = position.X + x;
+      if (screenX >= config->Resolution.X)
+	break;
+
+      if (mask[x >> 3] & (0x80 >> (x & 7)))
+	row[screenX >> columnShift] ^= color;
+    }
+}
+
+
+void _GfxTk_XorScreenSprite(VgaConfig *config,
+			    U16 page,
+			    Vector2d position,
+			    const VgaSprite *sprite,
+			    U8 color) {
+  if (!config->ScreenBuffer || !sprite || !sprite->Mask)
+    return;
+  if (position.X >= config->Resolution.X || position.Y >= config->Resolution.Y)
+    return;
+
+  const U16 height = (position.Y + sprite->Size.Y > config->Resolution.Y)
+    ? config->Resolution.Y - position.Y
+    : sprite->Size.Y;
+  volatile U8 *pageStart = (volatile U8*)config->ScreenBuffer + (page * _GfxTk_GetPageSize(config));
+
+  switch (config->ScreenModel) {
+  case VgaScreenLinear:
+    _XorBytePixels(config, pageStart, position, sprite, height, color, 0, 0);
+    break;
+
+  case VgaScreenUnchained:
+    // Reads and writes have to go to the plane of the pixels
+    for (U8 plane = 0; plane < 4; plane++) {
+      _GfxTk_SetPlaneMask(1 << plane);
+      _WriteGraphicsRegister(_GFXTK_INDEX_READMAP, plane);
+
+      U16 firstColumn = (plane - position.X) & 3;
+      _XorBytePixels(config, pageStart, position, sprite, height, color, firstColumn, 2);
+    }
+
+    _GfxTk_SetPlaneMask(0x0f);
+    _WriteGraphicsRegister(_GFXTK_INDEX_READMAP, 0);
+    break;
+
+  default:
+    _XorPlanarSprite(config, pageStart, position, sprite, height, color);
+  }
+}
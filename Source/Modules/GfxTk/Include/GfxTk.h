@@ -61,19 +61,146 @@ typedef struct Vector2d {
 } Vector2d;
 
 
+// Represents a rectangular area on the screen
+typedef struct Rect2d {
+  // The top left corner of the area
+  Vector2d Position;
+  // The width and height of the area
+  Vector2d Size;
+} Rect2d;
+
+
+
+// The maximum number of separate regions that are tracked as changed
+// between two refreshes. Further regions are merged into existing ones.
+#define VGA_DIRTY_RECT_COUNT 16
+
+
+// The maximum number of nested clip rects
+#define VGA_CLIP_DEPTH 8
+
+
+// The maximum number of overlays that are shown at the same time
+#define VGA_OVERLAY_COUNT 4
+
+
+// How the pixels of a backbuffer are stored
+typedef enum {
+  // One bit per pixel in each plane, like the screen
+  VgaPlanar = 0,
+  // One byte per pixel (the color), converted to planes on refresh
+  VgaChunky
+} VgaBufferFormat;
+
+
+// How the screen memory of a video mode is organized
+typedef enum {
+  // One bit per pixel in each of 4 planes (mode 12h)
+  VgaScreenPlanar = 0,
+  // One byte per pixel, all in one block (mode 13h)
+  VgaScreenLinear,
+  // One byte per pixel, every 4th pixel in the same plane (mode X)
+  VgaScreenUnchained
+} VgaScreenModel;
+
+
+// A small 1 bit per pixel image that is drawn straight to the screen
+// Rows are padded to whole bytes; the leftmost pixel is the highest bit.
+typedef struct VgaSprite {
+  Vector2d Size;
+  const U8 *Mask;
+} VgaSprite;
+
+
+// A sprite on top of the screen contents, like a text cursor or a mouse
+// pointer (see Renderer.ShowOverlay)
+// It is XORed into the visible page and never into the backbuffer, so
+// showing, hiding or moving it only touches the bytes below the sprite.
+typedef struct VgaOverlay {
+  const VgaSprite *Sprite;
+  Vector2d Position;
+  // The color bits that are flipped for the pixels of the sprite
+  U8 Color;
+  // Whether the overlay is shown (maintained by the renderer)
+  bool Visible;
+} VgaOverlay;
+
 
 typedef struct VgaConfig {
   Vector2d Resolution;
+  // The number of bits per color (4 for 16 colors, 8 for 256 colors)
   U16 PlaneCount;
 
+  // The layout of the backbuffer. Chunky backbuffers take one byte per
+  // pixel; planar ones only work with a planar screen, which in turn
+  // only shows 4 planes.
+  VgaBufferFormat Format;
+  // The layout of the screen memory (see Vga.SetMode)
+  VgaScreenModel ScreenModel;
+
   void* Backbuffer;
   void* ScreenBuffer;
+
+  // The regions of the backbuffer that changed since the last refresh
+  // They never overlap and are aligned to whole bytes (8 pixels).
+  Rect2d DirtyRects[VGA_DIRTY_RECT_COUNT];
+  U16 DirtyCount;
+
+  // The number of screen pages (2 with page flipping, otherwise 0 or 1)
+  U16 PageCount;
+  // The page that is currently displayed
+  U16 VisiblePage;
+  // The regions uploaded during the last refresh, which the other page
+  // is still missing
+  Rect2d PreviousDirtyRects[VGA_DIRTY_RECT_COUNT];
+  U16 PreviousDirtyCount;
+
+  // The stack of clip rects (see Renderer.PushClip)
+  // Each one lies within the one below it, and drawing is limited to
+  // the topmost one.
+  Rect2d ClipRects[VGA_CLIP_DEPTH];
+  U16 ClipDepth;
+
+  // The overlays on the visible page (see Renderer.ShowOverlay)
+  VgaOverlay *Overlays[VGA_OVERLAY_COUNT];
+  U16 OverlayCount;
 } VgaConfig;
 
 
 
+// How the VGA combines written data with the latched screen contents
+typedef enum {
+  VgaReplace = 0,
+  VgaAnd,
+  VgaOr,
+  VgaXor
+} VgaLogicOperation;
+
+
+// The video modes that Vga.SetMode can switch to
+typedef enum {
+  // 640x480 with 16 colors, planar
+  VgaMode12h = 0,
+  // 320x200 with 256 colors, linear (a single page)
+  VgaMode13h,
+  // 320x240 with 256 colors, unchained (3 pages)
+  VgaModeX
+} VgaMode;
+
+
+
 module (Vga) {
 
+  // Program the registers of a video mode and set up the config for it
+  // (resolution, planes, screen memory and its layout). The 256 color
+  // modes need a chunky backbuffer, which is provided by the caller just
+  // like a planar one. Page flipping and clipping are reset and the whole
+  // screen is invalidated. Returns false for unknown modes.
+  bool (*SetMode)(VgaConfig *config, VgaMode mode);
+
+  // Get the size of a screen page in one plane (in bytes)
+  U32 (*GetPageSize)(VgaConfig *config);
+
   // Enable the video output
   void (*EnableOutput)(void);
 
@@ -86,7 +213,8 @@ module (Vga) {
   // Set the plane mask for the next written bytes
   void (*SetPlaneMask)(U8 planeMask);
 
-  // Idle until the next vertical sync
+  // Idle until the next vertical sync, then upload the queued palette
+  // colors (see QueuePaletteRange)
   void (*PauseUntilVSync)(void);
 
   // Define a palette color (256 color definitions in parallel
@@ -98,6 +226,80 @@ module (Vga) {
   // color globally effects everything on the screen.
   void (*UseColor)(U8 index, U8 paletteIndex);
 
+  // Define consecutive palette colors, starting at an index, with a single
+  // burst to the DAC
+  void (*SetPaletteRange)(U8 start, U16 count, const Rgb18 *colors);
+
+  // Like SetPaletteRange, but the colors are held back until the next
+  // PauseUntilVSync (which Renderer.Refresh calls), so changing them does
+  // not tear the picture. Later calls overwrite earlier queued colors.
+  void (*QueuePaletteRange)(U8 start, U16 count, const Rgb18 *colors);
+
+  // Check if queued colors are waiting for the next PauseUntilVSync
+  bool (*HasQueuedPalette)(void);
+
+  // Like UseColor for consecutive colors, with a single reset of the
+  // attribute controller
+  void (*UseColorRange)(U8 index, U8 count, const U8 *paletteIndices);
+
+  // Select how CPU writes reach the planes
+  // 0: data (or set/reset) through logic operation and bitmask
+  // 1: copy the latches (filled by the last read)
+  // 2: the low 4 bits of the data are the color for all planes
+  void (*SetWriteMode)(U8 mode);
+
+  // Set the color that is written to planes with set/reset enabled
+  void (*SetSetReset)(U8 color);
+
+  // Enable set/reset for the planes in the mask (write mode 0)
+  void (*EnableSetReset)(U8 planeMask);
+
+  // Set how written data is combined with the latches
+  void (*SetLogicOperation)(VgaLogicOperation operation);
+
+  // Set the offset (in bytes per plane) of the first displayed pixel
+  // The change takes effect with the next frame.
+  void (*SetStartAddress)(U16 offset);
+
+  // Set the scanline after which the display continues at offset 0
+  // (split screen). Lines beyond the resolution disable the split.
+  void (*SetLineCompare)(U16 line);
+
+  // Refresh into a hidden second screen page and show it by changing the
+  // start address, instead of copying into the visible page. Returns
+  // false if two pages do not fit into a plane (64 KiB), which is the
+  // case for mode 12h and 13h.
+  bool (*EnablePageFlipping)(VgaConfig *config);
+
+  // Go back to refreshing the visible page
+  void (*DisablePageFlipping)(VgaConfig *config);
+
+  // Fill a rectangle directly on the screen, all planes at once (one
+  // write per 8 pixels). The backbuffer is not touched, so the next
+  // refresh of that region paints over it. Planar screens only.
+  void (*FillScreenRect)(VgaConfig *config,
+			 Vector2d position,
+			 Vector2d size,
+			 U8 color);
+
+  // Copy a region of the screen to another location through the latches.
+  // Horizontal positions and the width are rounded to whole bytes (8
+  // pixels); overlapping regions are handled. The backbuffer is not
+  // touched. Planar screens only.
+  void (*CopyScreenRect)(VgaConfig *config,
+			 Vector2d source,
+			 Vector2d destination,
+			 Vector2d size);
+
+  // XOR the pixels of a sprite with a color on a screen page, so drawing
+  // it a second time at the same place restores the screen. The
+  // backbuffer is not touched; pixels outside of the screen are skipped.
+  void (*XorScreenSprite)(VgaConfig *config,
+			  U16 page,
+			  Vector2d position,
+			  const VgaSprite *sprite,
+			  U8 color);
+
 };
 
 
@@ -139,6 +341,22 @@ typedef struct RenderChar {
 #define FONT_DEFAULT_LINESPACING 1
 
 
+// The number of sub-byte offsets a glyph can be drawn at
+#define GLYPH_CACHE_OFFSETS 8
+
+
+// Holds the glyphs of a font shifted to every sub-byte offset
+// Each row is stored as the two bytes it covers in a plane row (first
+// byte in the low half). The variants for an offset are built on the
+// first draw at that offset.
+typedef struct GlyphCache {
+  // One bit per offset whose variants have been built
+  U8 BuiltOffsets;
+
+  U16 Rows[GLYPH_CACHE_OFFSETS][FONT_CHAR_COUNT][sizeof(Bitmap8x8)];
+} GlyphCache;
+
+
 // Represents a prerendered bitmap font
 typedef struct Font {
   // The name of the font
@@ -151,8 +369,87 @@ typedef struct Font {
 
   // The glyphs
   RenderChar Char[FONT_CHAR_COUNT];
+
+  // The pre-shifted glyphs (optional)
+  GlyphCache *Cache;
 } Font;
 
+
+// A part of a text that is laid out as one line (see Renderer.LayoutText)
+typedef struct TextRun {
+  // The index of the first char
+  U32 Start;
+  // The number of chars (without the line break or the space the line
+  // was wrapped at)
+  U16 Length;
+  // The width of the chars, including their spacing (pixels)
+  U16 Width;
+} TextRun;
+
+
+// The maximum width and height of a glyph in a packed font
+#define PACKED_FONT_MAX_SIZE 16
+
+// Identifies a packed font image ("PF")
+#define PACKED_FONT_MAGIC 0x4650
+
+
+// The location of a glyph in the bitmap blob of a packed font
+// Only the rows between the first and the last set row are stored, each
+// as 1 byte (up to 8 pixels wide) or 2 bytes, with the leftmost pixel in
+// the most significant bit of the first byte.
+typedef struct PackedGlyph {
+  // The offset of the first stored row in the bitmap blob
+  U16 Offset;
+  // The width of the bitmap (pixels)
+  U8 Width;
+  // The distance to the next glyph, including the char spacing (pixels)
+  U8 Advance;
+  // The first stored row
+  U8 Top;
+  // The number of stored rows
+  U8 RowCount;
+} PackedGlyph;
+
+
+// The start of a packed font image
+// It is followed by the glyph table and the bitmap blob.
+typedef struct PackedFontHeader {
+  // Always PACKED_FONT_MAGIC
+  U16 Magic;
+  // The height of a line without the line spacing (pixels)
+  U8 Height;
+  // The space between lines (pixels)
+  U8 LineSpacing;
+  // The number of glyphs, starting at ' '
+  U16 GlyphCount;
+  // The size of the bitmap blob
+  U16 BitmapSize;
+} PackedFontHeader;
+
+
+// A font in the packed format, which refers to the tables of an image
+// (see Renderer.LoadPackedFont)
+typedef struct PackedFont {
+  U8 Height;
+  U8 LineSpacing;
+  U16 GlyphCount;
+
+  const PackedGlyph *Glyphs;
+  const U8 *Bitmaps;
+} PackedFont;
+
+
+// Refer to a font that was rendered at build time (see GFXTK_BAKED_FONTS
+// in the module Makefile), e.g. extern const Font BAKED_FONT(Widget);
+#define BAKED_FONT(fontId) _BAKED_FONT(fontId, )
+#define BAKED_MONOSPACE_FONT(fontId) _BAKED_FONT(fontId, Monospace)
+// Fonts baked with the :Packed option are PackedFonts
+#define BAKED_PACKED_FONT(fontId) _BAKED_FONT(fontId, Packed)
+#define BAKED_MONOSPACE_PACKED_FONT(fontId) _BAKED_FONT(fontId, MonospacePacked)
+#define _BAKED_FONT(fontId, variant) GfxTk_BakedFont_##fontId##variant
+
+
 typedef enum {
   Undefined = 0,
   CompressionShort,
@@ -177,6 +474,24 @@ typedef enum {
 } FontId;
 
 
+
+// A planar image, e.g. an icon or a prerendered part of the UI
+// The planes are stored one after another, each with Size.Y rows of
+// BytesPerRow bytes (leftmost pixel in the most significant bit), just
+// like the backbuffer.
+typedef struct Surface {
+  Vector2d Size;
+  U16 BytesPerRow;
+  U16 PlaneCount;
+
+  void* Pixels;
+
+  // Optional 1 bit per pixel mask in the same row layout as a plane
+  // Only pixels with their mask bit set are drawn.
+  U8* Mask;
+} Surface;
+
+
 module(Renderer) {
 
   // Render a character bitmap for later use. Characters can be rendered
@@ -206,30 +521,134 @@ module(Renderer) {
 		     U8 thickness,
 		     U8 color);
 
-  // Render a character at a specific location.
+  // Render a character at a specific location. Returns its advance, or 0
+  // for a missing glyph.
   U16 (*RenderChar)(VgaConfig *config,
 		     Vector2d position,
-		     RenderChar *glyph,
+		     const RenderChar *glyph,
 		     U8 color);
 
-  // Get a font bitmap by its id
-  Bitmap8x8* (*GetFontBitmap)(FontId fontId);
+  // Let text rendering with a font use pre-shifted glyphs. The cache
+  // memory is provided by the caller and must stay valid as long as the
+  // font is used; rendering the font again detaches it.
+  void (*EnableGlyphCache)(Font *font, GlyphCache *cache);
   
-  // Get the glyph of a certain ASCII character
-  RenderChar* (*GetGlyph)(Font *font, char asciiChar);
+  // Get the glyph of a certain ASCII character, or null if the font has
+  // none (control and non-ASCII characters)
+  const RenderChar* (*GetGlyph)(const Font *font, char asciiChar);
 
-  // Render a null-terminated string at a specific location.
+  // Render a null-terminated string at a specific location. Characters
+  // without a glyph are skipped.
   void (*RenderAsciiZ)(VgaConfig *config,
 		       Vector2d position,
 		       char *text,
-		       Font *font,
+		       const Font *font,
 		       U8 color);
 
-  // Fill the whole screen with a color
+  // Measure the width of a text up to a line break, the terminating zero
+  // or a number of chars (whatever comes first), as RenderAsciiZ would
+  // draw it.
+  U16 (*MeasureText)(const Font *font,
+		     const char *text,
+		     U32 length);
+
+  // Split a text (up to the terminating zero or a number of chars) into
+  // lines that fit into a width. Lines end at line breaks and are wrapped
+  // at the last space that fits, or within a word that does not fit on
+  // its own. Returns the number of runs written, which is at most
+  // maxRuns.
+  U32 (*LayoutText)(const Font *font,
+		    const char *text,
+		    U32 length,
+		    U16 width,
+		    TextRun *runs,
+		    U32 maxRuns);
+
+  // Convert a font into a packed font image. Returns the size of the
+  // image, or 0 if it does not fit into the capacity.
+  U32 (*PackFont)(const Font *source,
+		  void *image,
+		  U32 capacity);
+
+  // Set up a packed font from an image, which is used in place and must
+  // stay valid. Returns false if the image is malformed.
+  bool (*LoadPackedFont)(PackedFont *font,
+			 const void *image,
+			 U32 size);
+
+  // Render a null-terminated string with a packed font at a specific
+  // location. Characters the font has no glyph for are skipped.
+  void (*RenderPackedAsciiZ)(VgaConfig *config,
+			     Vector2d position,
+			     char *text,
+			     const PackedFont *font,
+			     U8 color);
+
+  // Draw a part of a surface at a specific location. The part is clipped
+  // against the surface and the screen.
+  void (*Blit)(VgaConfig *config,
+	       Surface *surface,
+	       Rect2d source,
+	       Vector2d destination);
+
+  // Fill the whole screen (or the current clip rect) with a color
   void (*FillScreen)(VgaConfig *config, U8 color);
 
+  // Limit all drawing to an area (within the current clip rect) until it
+  // is popped again. Returns false if the clip stack is full.
+  bool (*PushClip)(VgaConfig *config,
+		   Vector2d position,
+		   Vector2d size);
+
+  // Restore the clip rect that was active before the last push
+  void (*PopClip)(VgaConfig *config);
+
+  // Mark a region of the backbuffer as changed, so that the next refresh
+  // copies it to the screen. All render functions do this by themselves;
+  // it is only needed after writing to the backbuffer directly.
+  void (*Invalidate)(VgaConfig *config,
+		     Vector2d position,
+		     Vector2d size);
+
+  // Move the contents of a region up (positive rows) or down (negative)
+  // in the backbuffer. If the screen is current for the region (and not
+  // page flipped), it is moved there as well (through the VGA latches),
+  // so only the exposed rows need to be drawn and uploaded; otherwise
+  // the region is invalidated. The region is limited to the current
+  // clip rect, and its horizontal bounds are widened to whole bytes.
+  // Returns the exposed area, which keeps its previous contents.
+  Rect2d (*ScrollRegion)(VgaConfig *config,
+			 Vector2d position,
+			 Vector2d size,
+			 I16 rows);
+
   // Sync front and backbuffer
+  // Only the regions that changed since the last refresh are copied.
+  // Overlays stay on top; they are taken off the uploaded regions and
+  // drawn again right after. Queued palette colors are uploaded even if
+  // nothing else changed.
   void (*Refresh)(VgaConfig *config);
+
+  // Draw an overlay on top of the visible page, without touching the
+  // backbuffer or invalidating anything. Returns false if there is no
+  // screen or VGA_OVERLAY_COUNT overlays are shown already. Writing to
+  // the screen directly (Vga.FillScreenRect) does not keep overlays.
+  bool (*ShowOverlay)(VgaConfig *config, VgaOverlay *overlay);
+
+  // Take an overlay off the screen again
+  void (*HideOverlay)(VgaConfig *config, VgaOverlay *overlay);
+
+  // Move an overlay (if it is shown, only the bytes below the old and
+  // the new position are touched)
+  void (*MoveOverlay)(VgaConfig *config,
+		      VgaOverlay *overlay,
+		      Vector2d position);
+
+  // Convert a region of a chunky backbuffer to planes, which have the
+  // layout of a planar backbuffer. The region is widened to whole bytes.
+  void (*ChunkyToPlanar)(VgaConfig *config,
+			 Rect2d region,
+			 U8 *planes);
   
 };
 
@@ -0,0 +1,132 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#ifndef __FRAMEDUMP_H__
+#define __FRAMEDUMP_H__
+
+#include <stdio.h>
+#include <string.h>
+#include "../Include/GfxTk.h"
+
+
+// Host side output of a backbuffer. Frames are written as binary PPM
+// images, so they can be viewed and diffed without running the kernel.
+
+
+// The default colors of the 16 color modes
+static const Rgb18 FrameDump_DefaultPalette[16] = {
+  { 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x2a }, { 0x00, 0x2a, 0x00 }, { 0x00, 0x2a, 0x2a },
+  { 0x2a, 0x00, 0x00 }, { 0x2a, 0x00, 0x2a }, { 0x2a, 0x15, 0x00 }, { 0x2a, 0x2a, 0x2a },
+  { 0x15, 0x15, 0x15 }, { 0x15, 0x15, 0x3f }, { 0x15, 0x3f, 0x15 }, { 0x15, 0x3f, 0x3f },
+  { 0x3f, 0x15, 0x15 }, { 0x3f, 0x15, 0x3f }, { 0x3f, 0x3f, 0x15 }, { 0x3f, 0x3f, 0x3f }
+};
+
+
+// Get the color index of a pixel of the backbuffer
+static inline U8 FrameDump_GetPixel(const VgaConfig *config, U16 x, U16 y) {
+  if (config->Format == VgaChunky)
+    return ((U8*)config->Backbuffer)[(y * config->Resolution.X) + x] & 0xf;
+
+  const U16	bytesPerRow   = config->Resolution.X / 8;
+  const U32	bytesPerPlane = bytesPerRow * config->Resolution.Y;
+
+  const U8 *source = (U8*)config->Backbuffer + (y * bytesPerRow) + (x >> 3);
+  const U8 bitmask = 0x80 >> (x & 7);
+
+  U8 color = 0;
+  for (U8 plane = 0; plane < config->PlaneCount; plane++, source += bytesPerPlane)
+    if (*source & bitmask)
+      color |= 1 << plane;
+
+  return color;
+}
+
+
+// Get the 24 bit color of a pixel (the 6 bit DAC values are scaled up)
+static inline void FrameDump_GetRgb(const VgaConfig *config, const Rgb18 *palette, U16 x, U16 y, U8 rgb[3]) {
+  const Rgb18 color = palette[FrameDump_GetPixel(config, x, y)];
+
+  rgb[0] = (color.Red << 2) | (color.Red >> 4);
+  rgb[1] = (color.Green << 2) | (color.Green >> 4);
+  rgb[2] = (color.Blue << 2) | (color.Blue >> 4);
+}
+
+
+// Write the backbuffer as PPM image. Returns false if the file could not
+// be written.
+static inline bool FrameDump_WritePpm(const VgaConfig *config, const Rgb18 *palette, const char *path) {
+  FILE *file = fopen(path, "wb");
+  if (!file)
+    return false;
+
+  char header[32];
+  int headerLength = snprintf(header, sizeof(header), "P6\n%u %u\n255\n", config->Resolution.X, config->Resolution.Y);
+  bool written = fwrite(header, 1, headerLength, file) == (size_t)headerLength;
+
+  for (U16 y = 0; y < config->Resolution.Y && written; y++)
+    for (U16 x = 0; x < config->Resolution.X && written; x++) {
+      U8 rgb[3];
+      FrameDump_GetRgb(config, palette, x, y, rgb);
+      written = fwrite(rgb, 1, sizeof(rgb), file) == sizeof(rgb);
+    }
+
+  fclose(file);
+  return written;
+}
+
+
+// Compare the backbuffer with a PPM image (as written by
+// FrameDump_WritePpm) pixel by pixel. Returns false if they differ or the
+// image could not be read.
+static inline bool FrameDump_MatchesPpm(const VgaConfig *config, const Rgb18 *palette, const char *path) {
+  FILE *file = fopen(path, "rb");
+  if (!file)
+    return false;
+
+  char expectedHeader[32];
+  char header[32];
+  int headerLength = snprintf(expectedHeader, sizeof(expectedHeader), "P6\n%u %u\n255\n", config->Resolution.X, config->Resolution.Y);
+  bool matches = fread(header, 1, headerLength, file) == (size_t)headerLength
+    && !memcmp(header, expectedHeader, headerLength);
+
+  for (U16 y = 0; y < config->Resolution.Y && matches; y++)
+    for (U16 x = 0; x < config->Resolution.X && matches; x++) {
+      U8 expected[3];
+      U8 actual[3];
+      FrameDump_GetRgb(config, palette, x, y, actual);
+      matches = fread(expected, 1, sizeof(expected), file) == sizeof(expected)
+	&& !memcmp(expected, actual, sizeof(actual));
+    }
+
+  fclose(file);
+  return matches;
+}
+
+
+#endif
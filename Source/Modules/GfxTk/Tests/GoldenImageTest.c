@@ -0,0 +1,176 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+
+#include <stdlib.h>
+#include "MinUnit.h"
+#include "FrameDump.h"
+#include "../Include/GfxTk.h"
+#include "../Include/Font_ZXCourier.h"
+
+
+import(Renderer);
+
+
+// Every test renders a scene and compares it with a reference image in
+// the golden directory. Missing references are written instead, and all
+// of them are rewritten if GFXTK_UPDATE_GOLDEN is set. If a scene does
+// not match, the actual frame is written to the output directory for
+// diffing.
+
+#ifndef GFXTK_GOLDEN_DIR
+#define GFXTK_GOLDEN_DIR "Golden"
+#endif
+
+#ifndef GFXTK_FRAME_OUTPUT_DIR
+#define GFXTK_FRAME_OUTPUT_DIR "."
+#endif
+
+
+#define TEST_WIDTH 96
+#define TEST_HEIGHT 48
+#define TEST_PLANES 4
+
+static U8 _Backbuffer[(TEST_WIDTH / 8) * TEST_HEIGHT * TEST_PLANES];
+
+static Font _Font;
+static GlyphCache _Cache;
+
+
+// Create a config that is cleared to a background color
+static VgaConfig _CreateScene(U8 background) {
+  VgaConfig config = {
+    .Resolution = { TEST_WIDTH, TEST_HEIGHT },
+    .PlaneCount = TEST_PLANES,
+    .Backbuffer = _Backbuffer
+  };
+
+  Renderer.FillScreen(&config, background);
+  return config;
+}
+
+
+static bool _MatchesGolden(VgaConfig *config, const char *name) {
+  char path[256];
+  snprintf(path, sizeof(path), "%s/%s.ppm", GFXTK_GOLDEN_DIR, name);
+
+  FILE *file = fopen(path, "rb");
+  if (file)
+    fclose(file);
+
+  if (!file || getenv("GFXTK_UPDATE_GOLDEN")) {
+    printf("\nWriting golden image %s\n", path);
+    return FrameDump_WritePpm(config, FrameDump_DefaultPalette, path);
+  }
+
+  if (FrameDump_MatchesPpm(config, FrameDump_DefaultPalette, path))
+    return true;
+
+  snprintf(path, sizeof(path), "%s/%s.actual.ppm", GFXTK_FRAME_OUTPUT_DIR, name);
+  FrameDump_WritePpm(config, FrameDump_DefaultPalette, path);
+  printf("\nFrame differs from the golden image (see %s)\n", path);
+
+  return false;
+}
+
+
+
+// Scenes
+
+MU_TEST(Golden__RenderFilledRect) {
+  VgaConfig config = _CreateScene(0x1);
+
+  // Aligned, unaligned, within a single byte and beyond the screen
+  Renderer.RenderFilledRect(&config, (Vector2d) { 8, 4 }, (Vector2d) { 16, 10 }, 0xe);
+  Renderer.RenderFilledRect(&config, (Vector2d) { 29, 2 }, (Vector2d) { 23, 17 }, 0x4);
+  Renderer.RenderFilledRect(&config, (Vector2d) { 57, 6 }, (Vector2d) { 5, 30 }, 0xa);
+  Renderer.RenderFilledRect(&config, (Vector2d) { 70, 30 }, (Vector2d) { 40, 40 }, 0x7);
+  Renderer.RenderFilledRect(&config, (Vector2d) { 3, 25 }, (Vector2d) { 61, 13 }, 0xd);
+
+  mu_check(_MatchesGolden(&config, "RenderFilledRect"));
+}
+
+MU_TEST(Golden__RenderRect) {
+  VgaConfig config = _CreateScene(0x0);
+
+  Renderer.RenderRect(&config, (Vector2d) { 2, 2 }, (Vector2d) { 30, 20 }, 1, 0xf);
+  Renderer.RenderRect(&config, (Vector2d) { 37, 5 }, (Vector2d) { 25, 30 }, 3, 0xc);
+  Renderer.RenderRect(&config, (Vector2d) { 5, 27 }, (Vector2d) { 27, 15 }, 5, 0x9);
+  Renderer.RenderRect(&config, (Vector2d) { 70, 20 }, (Vector2d) { 40, 40 }, 2, 0xb);
+
+  mu_check(_MatchesGolden(&config, "RenderRect"));
+}
+
+MU_TEST(Golden__RenderChar) {
+  VgaConfig config = _CreateScene(0x8);
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Golden", false);
+
+  // Every sub-byte offset, and a glyph beyond the screen
+  for (U16 offset = 0; offset < 8; offset++)
+    Renderer.RenderChar(&config, (Vector2d) { offset * 9 + 4, 4 + (offset & 1) * 12 }, Renderer.GetGlyph(&_Font, 'A' + offset), offset + 8);
+  Renderer.RenderChar(&config, (Vector2d) { TEST_WIDTH - 3, TEST_HEIGHT - 5 }, Renderer.GetGlyph(&_Font, '#'), 0xf);
+
+  mu_check(_MatchesGolden(&config, "RenderChar"));
+}
+
+MU_TEST(Golden__RenderAsciiZ) {
+  VgaConfig config = _CreateScene(0x1);
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Golden", false);
+
+  Renderer.RenderAsciiZ(&config, (Vector2d) { 0, 0 }, "Golden text", &_Font, 0xf);
+  Renderer.RenderAsciiZ(&config, (Vector2d) { 3, 10 }, "0123456789", &_Font, 0xe);
+  Renderer.RenderAsciiZ(&config, (Vector2d) { 45, 40 }, "off the edge", &_Font, 0xa);
+
+  // Clipped and cached
+  Renderer.EnableGlyphCache(&_Font, &_Cache);
+  Renderer.PushClip(&config, (Vector2d) { 10, 20 }, (Vector2d) { 50, 6 });
+  Renderer.RenderAsciiZ(&config, (Vector2d) { 5, 19 }, "Clipped, cached", &_Font, 0xc);
+  Renderer.PopClip(&config);
+
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Golden", true);
+  Renderer.RenderAsciiZ(&config, (Vector2d) { 7, 30 }, "Mono", &_Font, 0xd);
+
+  mu_check(_MatchesGolden(&config, "RenderAsciiZ"));
+}
+
+MU_TEST_SUITE(GoldenImageSuite) {
+  MU_RUN_TEST(Golden__RenderFilledRect);
+  MU_RUN_TEST(Golden__RenderRect);
+  MU_RUN_TEST(Golden__RenderChar);
+  MU_RUN_TEST(Golden__RenderAsciiZ);
+}
+
+
+
+int main(void) {
+  MU_RUN_SUITE(GoldenImageSuite);
+
+  MU_REPORT();
+  return MU_EXIT_CODE;
+}
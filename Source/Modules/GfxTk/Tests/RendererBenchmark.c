@@ -0,0 +1,297 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "../../../../Tests/Benchmark.h"
+#include "../Include/GfxTk.h"
+#include "../Include/Font_ZXCourier.h"
+
+
+import(Renderer);
+
+
+#define SCREEN_WIDTH 640
+#define SCREEN_HEIGHT 480
+#define SCREEN_PLANES 4
+
+static U8 _Backbuffer[(SCREEN_WIDTH / 8) * SCREEN_HEIGHT * SCREEN_PLANES];
+
+static VgaConfig _Config = {
+  .Resolution = { SCREEN_WIDTH, SCREEN_HEIGHT },
+  .PlaneCount = SCREEN_PLANES,
+  .Backbuffer = _Backbuffer
+};
+
+// The same screen with a chunky backbuffer, and the planes it is
+// converted to
+static U8 _Chunky[SCREEN_WIDTH * SCREEN_HEIGHT];
+static U8 _Converted[sizeof(_Backbuffer)];
+
+static VgaConfig _ChunkyConfig = {
+  .Resolution = { SCREEN_WIDTH, SCREEN_HEIGHT },
+  .PlaneCount = SCREEN_PLANES,
+  .Format = VgaChunky,
+  .Backbuffer = _Chunky
+};
+
+static Font _Font;
+static GlyphCache _Cache;
+
+static U8 _PackedImage[4096];
+static PackedFont _PackedFont;
+static TextRun _Runs[64];
+
+
+
+// The former glyph renderer, which sets one pixel per plane at a time
+static U16 _RenderCharPixelwise(VgaConfig *config,
+				Vector2d position,
+				const RenderChar *glyph,
+				U8 color) {
+  const U16	bytesPerRow   = config->Resolution.X / 8;
+  const U32	bytesPerPlane = bytesPerRow * config->Resolution.Y;
+  
+  for (U16 rowIndex = 0; rowIndex < glyph->Size.Y; rowIndex++) {
+    U8 bitmapRow = glyph->Bitmap[rowIndex];
+
+    for (U16 columnIndex = 0; columnIndex < 8; columnIndex++) {
+      if ((bitmapRow & (1<< (7 - columnIndex))) == 0)
+	continue;
+      
+      U16 positionX = position.X + columnIndex;
+      U16 positionY = position.Y + rowIndex;
+
+      if (positionX >= config->Resolution.X ||
+	  positionY >= config->Resolution.Y)
+	continue;
+
+      U8 planeMask = 1;
+      for (U8 plane = 0; plane < config->PlaneCount; plane++, planeMask <<= 1) {
+	U8 planeBit = (color & planeMask)
+	  ? 1
+	  : 0;
+
+	U32 byteOffset = (positionY * (config->Resolution.X / 8)) + (positionX / 8);
+	U8 bitmask = 0x80 >> (positionX & 7);
+
+	U8* destination = config->Backbuffer + (plane * bytesPerPlane) + byteOffset;
+	if (planeBit)
+	  *destination |= bitmask;
+	else
+	  *destination &= ~bitmask;
+      }
+      
+    }
+  }
+
+  return glyph->Size.X;
+}
+
+
+static void _RenderAsciiZPixelwise(VgaConfig *config,
+				   Vector2d position,
+				   char *text,
+				   Font *font,
+				   U8 color) {
+  U16 offset = 0;
+  for (char *textPtr = text; *textPtr; textPtr++) {
+    Vector2d nextPos = {position.X + offset, position.Y };
+    const RenderChar *nextGlyph = Renderer.GetGlyph(font, *textPtr);
+    _RenderCharPixelwise(config, nextPos, nextGlyph, color);
+    offset += nextGlyph->Size.X + font->CharSpacing;
+  }
+}
+
+
+
+// The former row filler, called per scanline
+static void _FillRowBytewise(VgaConfig *config,
+			     Vector2d position,
+			     U16 width,
+			     U8 color) {
+  const U16	bytesPerRow   = config->Resolution.X / 8;
+  const U32	bytesPerPlane = bytesPerRow * config->Resolution.Y;
+
+  const U16	firstByteIndex = position.X >> 3;
+  const U16	lastPixelX     = position.X + width - 1;
+  const U16	lastByteIndex  = lastPixelX >> 3;
+
+  const U8	maskLeft  = 0xff >> (position.X & 7);
+  const U8	maskRight = 0xff << (7 - (lastPixelX & 7));
+
+  for (U8 plane = 0; plane < config->PlaneCount; plane++) {
+    U8 *planeAddress = config->Backbuffer + (bytesPerPlane * plane);
+    U8 *rowAddress = planeAddress + (position.Y * bytesPerRow);
+    U8 fillValue = (color & (1 << plane))
+      ? 0xff
+      : 0x00;
+
+    if (fillValue)
+      rowAddress[firstByteIndex] |= maskLeft;
+    else 
+      rowAddress[firstByteIndex] &= ~maskLeft;
+    
+    for (U16 byteIndex = firstByteIndex + 1; byteIndex < lastByteIndex; byteIndex++)
+      rowAddress[byteIndex] = fillValue;
+
+    if (fillValue)
+      rowAddress[lastByteIndex] |= maskRight;
+    else
+      rowAddress[lastByteIndex] &= ~maskRight;
+  }
+}
+
+
+static void _FillScreenBytewise(VgaConfig *config, U8 color) {
+  for (U16 line = 0; line < config->Resolution.Y; line++)
+    _FillRowBytewise(config, (Vector2d) { 0, line }, config->Resolution.X, color);
+}
+
+
+static void _RenderFilledRectBytewise(VgaConfig *config, Vector2d position, Vector2d size, U8 color) {
+  for (U16 row = position.Y; row < position.Y + size.Y; row++)
+    _FillRowBytewise(config, (Vector2d) { position.X, row }, size.X, color);
+}
+
+
+
+// A 32x32 icon with 4 planes and a mask
+static U8 _IconPixels[4 * 32 * 4];
+static U8 _IconMask[4 * 32];
+
+static Surface _Icon = {
+  .Size = { 32, 32 },
+  .BytesPerRow = 4,
+  .PlaneCount = 4,
+  .Pixels = _IconPixels,
+  .Mask = _IconMask
+};
+
+
+
+static char _Line[] = "The quick brown fox jumps over the lazy dog, 0123456789 times";
+
+
+// A frame like the shell draws it: a panel with 40 lines of text
+static void _DrawFrame(VgaConfig *config) {
+  Renderer.RenderFilledRect(config, (Vector2d) { 4, 20 }, (Vector2d) { 632, 440 }, 0x1);
+  for (U16 line = 0; line < 40; line++)
+    Renderer.RenderAsciiZ(config, (Vector2d) { 9, 24 + line * 10 }, _Line, &_Font, 0xf);
+}
+
+
+// Convert what a refresh would upload
+static void _ConvertDirtyRects(VgaConfig *config) {
+  for (U16 index = 0; index < config->DirtyCount; index++)
+    Renderer.ChunkyToPlanar(config, config->DirtyRects[index], _Converted);
+
+  config->DirtyCount = 0;
+}
+
+
+int main(void) {
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Text", false);
+  const RenderChar *glyph = Renderer.GetGlyph(&_Font, 'W');
+
+  BENCHMARK("RenderChar (pixelwise, unaligned)", 1000000,
+	    _RenderCharPixelwise(&_Config, (Vector2d) { 3 + (__benchmarkIndex & 0xff), 100 }, glyph, 0x5));
+  BENCHMARK("RenderChar (unaligned)", 1000000,
+	    { Renderer.RenderChar(&_Config, (Vector2d) { 3 + (__benchmarkIndex & 0xff), 100 }, glyph, 0x5);
+	      _Config.DirtyCount = 0; });
+
+  BENCHMARK("RenderAsciiZ, 61 chars (pixelwise)", 20000,
+	    _RenderAsciiZPixelwise(&_Config, (Vector2d) { 5, __benchmarkIndex & 0xff }, _Line, &_Font, 0x5));
+  BENCHMARK("RenderAsciiZ, 61 chars", 20000,
+	    { Renderer.RenderAsciiZ(&_Config, (Vector2d) { 5, __benchmarkIndex & 0xff }, _Line, &_Font, 0x5);
+	      _Config.DirtyCount = 0; });
+
+  Renderer.EnableGlyphCache(&_Font, &_Cache);
+  BENCHMARK("RenderAsciiZ, 61 chars (glyph cache)", 20000,
+	    { Renderer.RenderAsciiZ(&_Config, (Vector2d) { 5, __benchmarkIndex & 0xff }, _Line, &_Font, 0x5);
+	      _Config.DirtyCount = 0; });
+
+  Renderer.LoadPackedFont(&_PackedFont, _PackedImage, Renderer.PackFont(&_Font, _PackedImage, sizeof(_PackedImage)));
+  BENCHMARK("RenderPackedAsciiZ, 61 chars", 20000,
+	    { Renderer.RenderPackedAsciiZ(&_Config, (Vector2d) { 5, __benchmarkIndex & 0xff }, _Line, &_PackedFont, 0x5);
+	      _Config.DirtyCount = 0; });
+
+  BENCHMARK("MeasureText, 61 chars", 100000,
+	    Renderer.MeasureText(&_Font, _Line, sizeof(_Line)));
+  BENCHMARK("LayoutText, 61 chars into 100 pixels", 100000,
+	    Renderer.LayoutText(&_Font, _Line, sizeof(_Line), 100, _Runs, 64));
+
+  BENCHMARK("FillScreen (bytewise)", 2000,
+	    _FillScreenBytewise(&_Config, __benchmarkIndex));
+  BENCHMARK("FillScreen", 2000,
+	    { Renderer.FillScreen(&_Config, __benchmarkIndex);
+	      _Config.DirtyCount = 0; });
+
+  BENCHMARK("RenderFilledRect, 301x380 (bytewise)", 2000,
+	    _RenderFilledRectBytewise(&_Config, (Vector2d) { 18, 69 }, (Vector2d) { 301, 380 }, __benchmarkIndex));
+  BENCHMARK("RenderFilledRect, 301x380", 2000,
+	    { Renderer.RenderFilledRect(&_Config, (Vector2d) { 18, 69 }, (Vector2d) { 301, 380 }, __benchmarkIndex);
+	      _Config.DirtyCount = 0; });
+
+  BENCHMARK("RenderRect, 301x380, 3 pixels thick", 20000,
+	    { Renderer.RenderRect(&_Config, (Vector2d) { 18, 69 }, (Vector2d) { 301, 380 }, 3, __benchmarkIndex);
+	      _Config.DirtyCount = 0; });
+
+  Rect2d screenRect = { { 0, 0 }, { SCREEN_WIDTH, SCREEN_HEIGHT } };
+  BENCHMARK("ChunkyToPlanar, full screen", 2000,
+	    Renderer.ChunkyToPlanar(&_ChunkyConfig, screenRect, _Converted));
+
+  Rect2d iconRect = { { 0, 0 }, _Icon.Size };
+  BENCHMARK("Blit, 32x32 masked (aligned)", 100000,
+	    { Renderer.Blit(&_Config, &_Icon, iconRect, (Vector2d) { 64, __benchmarkIndex & 0xff });
+	      _Config.DirtyCount = 0; });
+  BENCHMARK("Blit, 32x32 masked (shifted)", 100000,
+	    { Renderer.Blit(&_Config, &_Icon, iconRect, (Vector2d) { 67, __benchmarkIndex & 0xff });
+	      _Config.DirtyCount = 0; });
+
+  // Both pipelines: drawing into planes, or into a chunky backbuffer that
+  // is converted afterwards
+  Renderer.EnableGlyphCache(&_Font, null);
+  BENCHMARK("RenderAsciiZ, 61 chars (chunky)", 20000,
+	    { Renderer.RenderAsciiZ(&_ChunkyConfig, (Vector2d) { 5, __benchmarkIndex & 0xff }, _Line, &_Font, 0x5);
+	      _ChunkyConfig.DirtyCount = 0; });
+  BENCHMARK("RenderFilledRect, 301x380 (chunky)", 2000,
+	    { Renderer.RenderFilledRect(&_ChunkyConfig, (Vector2d) { 18, 69 }, (Vector2d) { 301, 380 }, __benchmarkIndex);
+	      _ChunkyConfig.DirtyCount = 0; });
+  BENCHMARK("Blit, 32x32 masked (shifted, chunky)", 100000,
+	    { Renderer.Blit(&_ChunkyConfig, &_Icon, iconRect, (Vector2d) { 67, __benchmarkIndex & 0xff });
+	      _ChunkyConfig.DirtyCount = 0; });
+
+  BENCHMARK("Shell frame (planar)", 2000,
+	    { _DrawFrame(&_Config);
+	      _Config.DirtyCount = 0; });
+  BENCHMARK("Shell frame (chunky, converted)", 2000,
+	    { _DrawFrame(&_ChunkyConfig);
+	      _ConvertDirtyRects(&_ChunkyConfig); });
+
+  return 0;
+}
@@ -0,0 +1,1529 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "MinUnit.h"
+#include "../Include/GfxTk.h"
+#include "../Include/Font_ZXCourier.h"
+
+
+import(Renderer);
+
+
+// References
+
+MU_TEST(CModuleSetup__RendererMethods__HaveValidRef) {
+  mu_assert(Renderer.RenderCharBitmap != null, "RenderChar contains invalid pointer.");
+}
+
+MU_TEST_SUITE(CModuleSetup) {
+  MU_RUN_TEST(CModuleSetup__RendererMethods__HaveValidRef);
+}
+
+
+
+// Font renderer
+
+MU_TEST(RenderCharBitmap__Monospace__SetsFixedDimensions) {
+  Bitmap8x8 charBitmap[] = {
+    0b10101010,
+    0b01010101,
+    0b10101010,
+    0b01010101,
+    0b10101010,
+    0b01010101,
+    0b10101010,
+    0b01010101
+  };
+  
+  RenderChar result = { };
+  Renderer.RenderCharBitmap(&result, charBitmap, true);
+
+  mu_assert_int_eq(8, result.Size.Y);
+  mu_assert_int_eq(8, result.Size.X);
+  for (U8 bitmapIndex = 0; bitmapIndex < sizeof(Bitmap8x8); bitmapIndex++)
+    mu_check(((U8*)charBitmap)[bitmapIndex] == result.Bitmap[bitmapIndex]);
+}
+
+MU_TEST(RenderCharBitmap__NonMonospace__SetsProportionalDimensions) {
+  Bitmap8x8 charBitmap[] = {
+    0b00001100,
+    0b00001100,
+    0b00001100,
+    0b00001100,
+    0b00001110,
+    0b00001100,
+    0b00001100,
+    0b00011100
+  };
+  
+  RenderChar result = { };
+  Renderer.RenderCharBitmap(&result, charBitmap, false);
+
+  mu_assert_int_eq(8, result.Size.Y);
+  mu_assert_int_eq(4, result.Size.X);
+  // The result is left aligned, the source stays untouched
+  for (U8 bitmapIndex = 0; bitmapIndex < sizeof(Bitmap8x8); bitmapIndex++)
+    mu_check((U8)(((U8*)charBitmap)[bitmapIndex] << 3) == result.Bitmap[bitmapIndex]);
+}
+
+MU_TEST(RenderCharBitmap__InvalidInput__ReturnsDefault) {
+  RenderChar result = { };
+  Renderer.RenderCharBitmap(&result, null, false);
+
+  mu_assert_int_eq(0, result.Size.Y);
+  mu_assert_int_eq(0, result.Size.X);
+  for (U8 bitmapIndex = 0; bitmapIndex < sizeof(Bitmap8x8); bitmapIndex++)
+    mu_check(result.Bitmap[bitmapIndex] == 0);
+}
+
+MU_TEST_SUITE(RenderCharBitmap) {
+  MU_RUN_TEST(RenderCharBitmap__Monospace__SetsFixedDimensions);
+  MU_RUN_TEST(RenderCharBitmap__NonMonospace__SetsProportionalDimensions);
+  MU_RUN_TEST(RenderCharBitmap__InvalidInput__ReturnsDefault);
+}
+
+
+
+MU_TEST(RenderFont__Proportional__RendersFont) {
+  Font result = { };
+  Bitmap8x8* bitmap = (Bitmap8x8*)FONT_ZX_COURIER_BITMAP;
+  const char name[] = "Name";
+
+  Renderer.RenderFont(&result, bitmap, name, false);
+
+  mu_assert_int_eq(FONT_DEFAULT_CHARSPACING, result.CharSpacing);
+  mu_assert_int_eq(FONT_DEFAULT_LINESPACING, result.LineSpacing);
+  mu_assert_string_eq(name, (char*)result.Name);
+}
+
+MU_TEST(RenderFont__Monospace__RendersFont) {
+  Font result = { };
+  Bitmap8x8* bitmap = (Bitmap8x8*)FONT_ZX_COURIER_BITMAP;
+  const char name[] = "Name";
+
+  Renderer.RenderFont(&result, bitmap, name, true);
+
+  mu_assert_int_eq(FONT_DEFAULT_CHARSPACING, result.CharSpacing);
+  mu_assert_int_eq(FONT_DEFAULT_LINESPACING, result.LineSpacing);
+  mu_assert_string_eq(name, (char*)result.Name);
+}
+
+MU_TEST_SUITE(RenderFont) {
+  MU_RUN_TEST(RenderFont__Proportional__RendersFont);
+  MU_RUN_TEST(RenderFont__Monospace__RendersFont);
+}
+
+
+
+// Character blitting
+
+#define TEST_WIDTH 64
+#define TEST_HEIGHT 16
+#define TEST_PLANES 4
+
+static U8 _Backbuffer[(TEST_WIDTH / 8) * TEST_HEIGHT * TEST_PLANES];
+static U8 _Expected[sizeof(_Backbuffer)];
+
+
+static VgaConfig _CreateTestConfig(void *backbuffer) {
+  return (VgaConfig) {
+    .Resolution = { TEST_WIDTH, TEST_HEIGHT },
+    .PlaneCount = TEST_PLANES,
+    .Backbuffer = backbuffer
+  };
+}
+
+
+// Set the pixels of a glyph one by one
+static void _RenderCharPixelwise(VgaConfig *config, Vector2d position, RenderChar *glyph, U8 color) {
+  const U16 bytesPerRow = config->Resolution.X / 8;
+  const U32 bytesPerPlane = bytesPerRow * config->Resolution.Y;
+
+  for (U16 row = 0; row < glyph->Size.Y; row++)
+    for (U16 column = 0; column < 8; column++) {
+      U16 x = position.X + column;
+      U16 y = position.Y + row;
+      if (!(glyph->Bitmap[row] & (0x80 >> column)) || x >= config->Resolution.X || y >= config->Resolution.Y)
+	continue;
+
+      for (U8 plane = 0; plane < config->PlaneCount; plane++) {
+	U8 *destination = (U8*)config->Backbuffer + (plane * bytesPerPlane) + (y * bytesPerRow) + (x / 8);
+	if (color & (1 << plane))
+	  *destination |= 0x80 >> (x & 7);
+	else
+	  *destination &= ~(0x80 >> (x & 7));
+      }
+    }
+}
+
+
+static void _FillPlanes(U8 *buffer, U8 color) {
+  const U32 bytesPerPlane = (TEST_WIDTH / 8) * TEST_HEIGHT;
+
+  for (U32 index = 0; index < bytesPerPlane * TEST_PLANES; index++)
+    buffer[index] = (color & (1 << (index / bytesPerPlane))) ? 0xff : 0x00;
+}
+
+
+static bool _RenderCharMatches(Vector2d position, U8 color, U8 background) {
+  RenderChar glyph = {
+    .Size = { 8, 8 },
+    .Bitmap = { 0x81, 0x42, 0x24, 0x18, 0xff, 0x3c, 0xa5, 0x7e }
+  };
+
+  VgaConfig actual = _CreateTestConfig(_Backbuffer);
+  VgaConfig expected = _CreateTestConfig(_Expected);
+  _FillPlanes(_Backbuffer, background);
+  _FillPlanes(_Expected, background);
+
+  Renderer.RenderChar(&actual, position, &glyph, color);
+  _RenderCharPixelwise(&expected, position, &glyph, color);
+
+  for (U32 index = 0; index < sizeof(_Backbuffer); index++)
+    if (_Backbuffer[index] != _Expected[index])
+      return false;
+
+  return true;
+}
+
+
+MU_TEST(RenderChar__ByteAligned__MatchesPixelwise) {
+  mu_check(_RenderCharMatches((Vector2d) { 8, 2 }, 0x5, 0x0));
+  mu_check(_RenderCharMatches((Vector2d) { 0, 0 }, 0xf, 0x0));
+}
+
+MU_TEST(RenderChar__Unaligned__MatchesPixelwise) {
+  for (U16 x = 1; x < 8; x++)
+    mu_check(_RenderCharMatches((Vector2d) { 16 + x, 3 }, 0x9, 0x0));
+}
+
+MU_TEST(RenderChar__ClearingPlanes__MatchesPixelwise) {
+  for (U16 x = 0; x < 8; x++)
+    mu_check(_RenderCharMatches((Vector2d) { 24 + x, 1 }, 0x2, 0xf));
+}
+
+MU_TEST(RenderChar__RightEdge__IsClipped) {
+  mu_check(_RenderCharMatches((Vector2d) { TEST_WIDTH - 3, 0 }, 0xf, 0x0));
+  mu_check(_RenderCharMatches((Vector2d) { TEST_WIDTH - 8, 0 }, 0xf, 0x0));
+}
+
+MU_TEST(RenderChar__BottomEdge__IsClipped) {
+  mu_check(_RenderCharMatches((Vector2d) { 13, TEST_HEIGHT - 3 }, 0x7, 0x0));
+}
+
+MU_TEST(RenderChar__OffScreen__DrawsNothing) {
+  mu_check(_RenderCharMatches((Vector2d) { TEST_WIDTH, 0 }, 0xf, 0x0));
+  mu_check(_RenderCharMatches((Vector2d) { 0, TEST_HEIGHT }, 0xf, 0x0));
+}
+
+MU_TEST(RenderChar__Always__ReturnsGlyphWidth) {
+  RenderChar glyph = { .Size = { 5, 8 } };
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+
+  mu_assert_int_eq(5, Renderer.RenderChar(&config, (Vector2d) { 3, 3 }, &glyph, 1));
+}
+
+MU_TEST_SUITE(RenderCharBlit) {
+  MU_RUN_TEST(RenderChar__ByteAligned__MatchesPixelwise);
+  MU_RUN_TEST(RenderChar__Unaligned__MatchesPixelwise);
+  MU_RUN_TEST(RenderChar__ClearingPlanes__MatchesPixelwise);
+  MU_RUN_TEST(RenderChar__RightEdge__IsClipped);
+  MU_RUN_TEST(RenderChar__BottomEdge__IsClipped);
+  MU_RUN_TEST(RenderChar__OffScreen__DrawsNothing);
+  MU_RUN_TEST(RenderChar__Always__ReturnsGlyphWidth);
+}
+
+
+
+// Rect filling
+
+// The former row filler, which all rect rendering was based on
+static void _FillRowBytewise(VgaConfig *config, Vector2d position, U16 width, U8 color) {
+  if (!width)
+    return;
+
+  const U16 bytesPerRow = config->Resolution.X / 8;
+  const U32 bytesPerPlane = bytesPerRow * config->Resolution.Y;
+
+  const U16 firstByteIndex = position.X >> 3;
+  const U16 lastPixelX = position.X + width - 1;
+  const U16 lastByteIndex = lastPixelX >> 3;
+
+  const U8 maskLeft = 0xff >> (position.X & 7);
+  const U8 maskRight = 0xff << (7 - (lastPixelX & 7));
+
+  for (U8 plane = 0; plane < config->PlaneCount; plane++) {
+    U8 *rowAddress = (U8*)config->Backbuffer + (bytesPerPlane * plane) + (position.Y * bytesPerRow);
+    U8 fillValue = (color & (1 << plane)) ? 0xff : 0x00;
+
+    if (firstByteIndex == lastByteIndex) {
+      U8 mask = maskLeft & maskRight;
+      rowAddress[firstByteIndex] = fillValue ? rowAddress[firstByteIndex] | mask : rowAddress[firstByteIndex] & ~mask;
+      continue;
+    }
+
+    rowAddress[firstByteIndex] = fillValue ? rowAddress[firstByteIndex] | maskLeft : rowAddress[firstByteIndex] & ~maskLeft;
+    for (U16 byteIndex = firstByteIndex + 1; byteIndex < lastByteIndex; byteIndex++)
+      rowAddress[byteIndex] = fillValue;
+    rowAddress[lastByteIndex] = fillValue ? rowAddress[lastByteIndex] | maskRight : rowAddress[lastByteIndex] & ~maskRight;
+  }
+}
+
+
+static void _RenderFilledRectBytewise(VgaConfig *config, Vector2d position, Vector2d size, U8 color) {
+  U16 width = position.X + size.X > config->Resolution.X ? config->Resolution.X - position.X : size.X;
+  U16 height = position.Y + size.Y > config->Resolution.Y ? config->Resolution.Y - position.Y : size.Y;
+
+  for (U16 row = position.Y; row < position.Y + height; row++)
+    _FillRowBytewise(config, (Vector2d) { position.X, row }, width, color);
+}
+
+
+static void _RenderRectBytewise(VgaConfig *config, Vector2d position, Vector2d size, U8 thickness, U8 color) {
+  U16 width = position.X + size.X > config->Resolution.X ? config->Resolution.X - position.X : size.X;
+  U16 height = position.Y + size.Y > config->Resolution.Y ? config->Resolution.Y - position.Y : size.Y;
+  U16 lastRow = position.Y + height;
+  U16 bottomStart = position.Y + height - thickness;
+
+  for (U16 row = position.Y; row < position.Y + thickness; row++)
+    _FillRowBytewise(config, (Vector2d) { position.X, row }, width, color);
+  for (U16 row = bottomStart; row < lastRow; row++)
+    _FillRowBytewise(config, (Vector2d) { position.X, row }, width, color);
+  for (U16 row = position.Y + thickness; row < bottomStart; row++) {
+    _FillRowBytewise(config, (Vector2d) { position.X, row }, thickness, color);
+    _FillRowBytewise(config, (Vector2d) { position.X + width - thickness, row }, thickness, color);
+  }
+}
+
+
+static bool _BuffersMatch(void) {
+  for (U32 index = 0; index < sizeof(_Backbuffer); index++)
+    if (_Backbuffer[index] != _Expected[index])
+      return false;
+
+  return true;
+}
+
+
+static bool _FilledRectMatches(Vector2d position, Vector2d size, U8 color) {
+  VgaConfig actual = _CreateTestConfig(_Backbuffer);
+  VgaConfig expected = _CreateTestConfig(_Expected);
+  _FillPlanes(_Backbuffer, 0x6);
+  _FillPlanes(_Expected, 0x6);
+
+  Renderer.RenderFilledRect(&actual, position, size, color);
+  _RenderFilledRectBytewise(&expected, position, size, color);
+
+  return _BuffersMatch();
+}
+
+
+static bool _RectMatches(Vector2d position, Vector2d size, U8 thickness, U8 color) {
+  VgaConfig actual = _CreateTestConfig(_Backbuffer);
+  VgaConfig expected = _CreateTestConfig(_Expected);
+  _FillPlanes(_Backbuffer, 0x6);
+  _FillPlanes(_Expected, 0x6);
+
+  Renderer.RenderRect(&actual, position, size, thickness, color);
+  _RenderRectBytewise(&expected, position, size, thickness, color);
+
+  return _BuffersMatch();
+}
+
+
+MU_TEST(RenderFilledRect__AnyBounds__MatchesBytewise) {
+  for (U16 x = 0; x < 20; x += 3)
+    for (U16 width = 1; width < 40; width += 5)
+      mu_check(_FilledRectMatches((Vector2d) { x, 2 }, (Vector2d) { width, 5 }, 0x9));
+}
+
+MU_TEST(RenderFilledRect__WithinOneByte__MatchesBytewise) {
+  mu_check(_FilledRectMatches((Vector2d) { 9, 0 }, (Vector2d) { 3, 4 }, 0x1));
+  mu_check(_FilledRectMatches((Vector2d) { 8, 0 }, (Vector2d) { 8, 4 }, 0x1));
+}
+
+MU_TEST(RenderFilledRect__FullWidth__MatchesBytewise) {
+  mu_check(_FilledRectMatches((Vector2d) { 0, 3 }, (Vector2d) { TEST_WIDTH, 7 }, 0xa));
+}
+
+MU_TEST(RenderFilledRect__BeyondEdges__MatchesBytewise) {
+  mu_check(_FilledRectMatches((Vector2d) { 50, 10 }, (Vector2d) { 40, 40 }, 0xf));
+}
+
+MU_TEST(RenderRect__AnyBounds__MatchesBytewise) {
+  for (U16 x = 0; x < 16; x += 5)
+    for (U8 thickness = 1; thickness < 4; thickness++)
+      mu_check(_RectMatches((Vector2d) { x, 1 }, (Vector2d) { 30, 12 }, thickness, 0x5));
+}
+
+MU_TEST(FillScreen__Always__MatchesBytewise) {
+  VgaConfig actual = _CreateTestConfig(_Backbuffer);
+  _FillPlanes(_Backbuffer, 0x6);
+  _FillPlanes(_Expected, 0x9);
+
+  Renderer.FillScreen(&actual, 0x9);
+
+  mu_check(_BuffersMatch());
+}
+
+MU_TEST_SUITE(RenderFilledRectSuite) {
+  MU_RUN_TEST(RenderFilledRect__AnyBounds__MatchesBytewise);
+  MU_RUN_TEST(RenderFilledRect__WithinOneByte__MatchesBytewise);
+  MU_RUN_TEST(RenderFilledRect__FullWidth__MatchesBytewise);
+  MU_RUN_TEST(RenderFilledRect__BeyondEdges__MatchesBytewise);
+  MU_RUN_TEST(RenderRect__AnyBounds__MatchesBytewise);
+  MU_RUN_TEST(FillScreen__Always__MatchesBytewise);
+}
+
+
+
+// Scrolling
+
+// Give every row of every plane a distinct pattern
+static void _FillRowPattern(U8 *buffer) {
+  for (U32 index = 0; index < sizeof(_Backbuffer); index++)
+    buffer[index] = (U8)(index / (TEST_WIDTH / 8)) * 7 + 1;
+}
+
+
+static bool _RowsMatch(U8 *buffer, U16 row, U16 sourceRow, U16 firstByte, U16 byteCount) {
+  const U16 bytesPerRow = TEST_WIDTH / 8;
+  const U32 bytesPerPlane = bytesPerRow * TEST_HEIGHT;
+
+  for (U8 plane = 0; plane < TEST_PLANES; plane++)
+    for (U16 byte = firstByte; byte < firstByte + byteCount; byte++)
+      if (buffer[plane * bytesPerPlane + row * bytesPerRow + byte]
+	  != _Expected[plane * bytesPerPlane + sourceRow * bytesPerRow + byte])
+	return false;
+
+  return true;
+}
+
+
+MU_TEST(ScrollRegion__Up__MovesRowsAndExposesBottom) {
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+  _FillRowPattern(_Backbuffer);
+  _FillRowPattern(_Expected);
+
+  Rect2d exposed = Renderer.ScrollRegion(&config, (Vector2d) { 16, 2 }, (Vector2d) { 24, 10 }, 3);
+
+  mu_assert_int_eq(16, exposed.Position.X);
+  mu_assert_int_eq(9, exposed.Position.Y);
+  mu_assert_int_eq(24, exposed.Size.X);
+  mu_assert_int_eq(3, exposed.Size.Y);
+  for (U16 row = 2; row < 9; row++)
+    mu_check(_RowsMatch(_Backbuffer, row, row + 3, 2, 3));
+
+  // Bytes beside the region stay untouched
+  mu_check(_RowsMatch(_Backbuffer, 2, 2, 0, 2));
+  mu_check(_RowsMatch(_Backbuffer, 2, 2, 5, 3));
+}
+
+MU_TEST(ScrollRegion__Down__MovesRowsAndExposesTop) {
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+  _FillRowPattern(_Backbuffer);
+  _FillRowPattern(_Expected);
+
+  Rect2d exposed = Renderer.ScrollRegion(&config, (Vector2d) { 0, 4 }, (Vector2d) { TEST_WIDTH, 12 }, -5);
+
+  mu_assert_int_eq(4, exposed.Position.Y);
+  mu_assert_int_eq(5, exposed.Size.Y);
+  for (U16 row = 9; row < 16; row++)
+    mu_check(_RowsMatch(_Backbuffer, row, row - 5, 0, TEST_WIDTH / 8));
+}
+
+MU_TEST(ScrollRegion__UnalignedBounds__MovesWholeBytes) {
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+  _FillRowPattern(_Backbuffer);
+  _FillRowPattern(_Expected);
+
+  Renderer.ScrollRegion(&config, (Vector2d) { 13, 0 }, (Vector2d) { 12, 8 }, 1);
+
+  for (U16 row = 0; row < 7; row++)
+    mu_check(_RowsMatch(_Backbuffer, row, row + 1, 1, 3));
+  mu_check(_RowsMatch(_Backbuffer, 0, 0, 4, 4));
+}
+
+MU_TEST(ScrollRegion__WholeHeight__ExposesRegionOnly) {
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+  _FillRowPattern(_Backbuffer);
+  _FillRowPattern(_Expected);
+
+  Rect2d exposed = Renderer.ScrollRegion(&config, (Vector2d) { 8, 2 }, (Vector2d) { 8, 4 }, 4);
+
+  mu_assert_int_eq(2, exposed.Position.Y);
+  mu_assert_int_eq(4, exposed.Size.Y);
+  mu_check(_BuffersMatch());
+}
+
+MU_TEST(ScrollRegion__WithoutScreen__InvalidatesRegion) {
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+
+  Renderer.ScrollRegion(&config, (Vector2d) { 10, 2 }, (Vector2d) { 20, 10 }, 2);
+
+  mu_assert_int_eq(1, config.DirtyCount);
+  mu_assert_int_eq(8, config.DirtyRects[0].Position.X);
+  mu_assert_int_eq(24, config.DirtyRects[0].Size.X);
+  mu_assert_int_eq(10, config.DirtyRects[0].Size.Y);
+}
+
+MU_TEST_SUITE(ScrollRegionSuite) {
+  MU_RUN_TEST(ScrollRegion__Up__MovesRowsAndExposesBottom);
+  MU_RUN_TEST(ScrollRegion__Down__MovesRowsAndExposesTop);
+  MU_RUN_TEST(ScrollRegion__UnalignedBounds__MovesWholeBytes);
+  MU_RUN_TEST(ScrollRegion__WholeHeight__ExposesRegionOnly);
+  MU_RUN_TEST(ScrollRegion__WithoutScreen__InvalidatesRegion);
+}
+
+
+
+// Page flipping
+
+import(Vga);
+
+
+MU_TEST(EnablePageFlipping__PagesExceedPlane__ReturnsFalse) {
+  VgaConfig config = {
+    .Resolution = { 640, 480 },
+    .PlaneCount = 4,
+    .Backbuffer = _Backbuffer,
+    .ScreenBuffer = _Expected
+  };
+
+  mu_check(!Vga.EnablePageFlipping(&config));
+  mu_assert_int_eq(0, config.PageCount);
+  mu_assert_int_eq(0, config.DirtyCount);
+}
+
+MU_TEST(EnablePageFlipping__NoScreen__ReturnsFalse) {
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+
+  mu_check(!Vga.EnablePageFlipping(&config));
+  mu_assert_int_eq(0, config.PageCount);
+}
+
+MU_TEST(GetPageSize__ScreenModels__ReturnsBytesPerPlane) {
+  VgaConfig config = { .Resolution = { 640, 480 }, .ScreenModel = VgaScreenPlanar };
+  mu_assert_int_eq(38400, Vga.GetPageSize(&config));
+
+  config = (VgaConfig) { .Resolution = { 320, 200 }, .ScreenModel = VgaScreenLinear };
+  mu_assert_int_eq(64000, Vga.GetPageSize(&config));
+
+  config = (VgaConfig) { .Resolution = { 320, 240 }, .ScreenModel = VgaScreenUnchained };
+  mu_assert_int_eq(19200, Vga.GetPageSize(&config));
+}
+
+MU_TEST_SUITE(PageFlippingSuite) {
+  MU_RUN_TEST(EnablePageFlipping__PagesExceedPlane__ReturnsFalse);
+  MU_RUN_TEST(EnablePageFlipping__NoScreen__ReturnsFalse);
+  MU_RUN_TEST(GetPageSize__ScreenModels__ReturnsBytesPerPlane);
+}
+
+
+
+// Blitting
+
+#define SURFACE_WIDTH 21
+#define SURFACE_HEIGHT 6
+#define SURFACE_BYTES_PER_ROW 3
+
+static U8 _SurfacePixels[SURFACE_BYTES_PER_ROW * SURFACE_HEIGHT * TEST_PLANES];
+static U8 _SurfaceMask[SURFACE_BYTES_PER_ROW * SURFACE_HEIGHT];
+
+
+static Surface _CreateTestSurface(bool masked) {
+  for (U32 index = 0; index < sizeof(_SurfacePixels); index++)
+    _SurfacePixels[index] = (U8)(index * 37 + 11);
+  for (U32 index = 0; index < sizeof(_SurfaceMask); index++)
+    _SurfaceMask[index] = (U8)(index * 53 + 5);
+
+  return (Surface) {
+    .Size = { SURFACE_WIDTH, SURFACE_HEIGHT },
+    .BytesPerRow = SURFACE_BYTES_PER_ROW,
+    .PlaneCount = TEST_PLANES,
+    .Pixels = _SurfacePixels,
+    .Mask = masked ? _SurfaceMask : null
+  };
+}
+
+
+static bool _GetBit(const U8 *row, U16 x) {
+  return row[x >> 3] & (0x80 >> (x & 7));
+}
+
+
+// Copy the pixels one by one
+static void _BlitPixelwise(VgaConfig *config, Surface *surface, Rect2d source, Vector2d destination) {
+  const U16 bytesPerRow = config->Resolution.X / 8;
+  const U32 bytesPerPlane = bytesPerRow * config->Resolution.Y;
+
+  for (U16 row = 0; row < source.Size.Y; row++)
+    for (U16 column = 0; column < source.Size.X; column++) {
+      U16 sourceX = source.Position.X + column, sourceY = source.Position.Y + row;
+      U16 x = destination.X + column, y = destination.Y + row;
+      if (sourceX >= surface->Size.X || sourceY >= surface->Size.Y
+	  || x >= config->Resolution.X || y >= config->Resolution.Y)
+	continue;
+      if (surface->Mask && !_GetBit(surface->Mask + sourceY * surface->BytesPerRow, sourceX))
+	continue;
+
+      for (U8 plane = 0; plane < config->PlaneCount; plane++) {
+	const U8 *sourceRow = (U8*)surface->Pixels + plane * surface->BytesPerRow * surface->Size.Y + sourceY * surface->BytesPerRow;
+	U8 *destinationByte = (U8*)config->Backbuffer + plane * bytesPerPlane + y * bytesPerRow + (x >> 3);
+
+	if (_GetBit(sourceRow, sourceX))
+	  *destinationByte |= 0x80 >> (x & 7);
+	else
+	  *destinationByte &= ~(0x80 >> (x & 7));
+      }
+    }
+}
+
+
+static bool _BlitMatches(bool masked, Rect2d source, Vector2d destination) {
+  VgaConfig actual = _CreateTestConfig(_Backbuffer);
+  VgaConfig expected = _CreateTestConfig(_Expected);
+  Surface surface = _CreateTestSurface(masked);
+  _FillPlanes(_Backbuffer, 0x5);
+  _FillPlanes(_Expected, 0x5);
+
+  Renderer.Blit(&actual, &surface, source, destination);
+  _BlitPixelwise(&expected, &surface, source, destination);
+
+  return _BuffersMatch();
+}
+
+
+MU_TEST(Blit__Aligned__MatchesPixelwise) {
+  Rect2d whole = { { 0, 0 }, { SURFACE_WIDTH, SURFACE_HEIGHT } };
+
+  mu_check(_BlitMatches(false, whole, (Vector2d) { 16, 3 }));
+  mu_check(_BlitMatches(false, (Rect2d) { { 3, 1 }, { 14, 4 } }, (Vector2d) { 11, 2 }));
+  mu_check(_BlitMatches(true, whole, (Vector2d) { 8, 0 }));
+}
+
+MU_TEST(Blit__Shifted__MatchesPixelwise) {
+  for (U16 sourceX = 0; sourceX < 8; sourceX++)
+    for (U16 x = 0; x < 8; x++) {
+      Rect2d source = { { sourceX, 1 }, { 11, 4 } };
+      mu_check(_BlitMatches(false, source, (Vector2d) { 17 + x, 5 }));
+      mu_check(_BlitMatches(true, source, (Vector2d) { 17 + x, 5 }));
+    }
+}
+
+MU_TEST(Blit__BeyondScreen__IsClipped) {
+  Rect2d whole = { { 0, 0 }, { SURFACE_WIDTH, SURFACE_HEIGHT } };
+
+  mu_check(_BlitMatches(true, whole, (Vector2d) { TEST_WIDTH - 13, TEST_HEIGHT - 2 }));
+  mu_check(_BlitMatches(false, whole, (Vector2d) { TEST_WIDTH - 8, 0 }));
+}
+
+MU_TEST(Blit__BeyondSurface__IsClipped) {
+  mu_check(_BlitMatches(false, (Rect2d) { { 15, 4 }, { 30, 30 } }, (Vector2d) { 2, 2 }));
+  mu_check(_BlitMatches(false, (Rect2d) { { SURFACE_WIDTH, 0 }, { 5, 5 } }, (Vector2d) { 2, 2 }));
+}
+
+MU_TEST(Blit__Always__InvalidatesClippedArea) {
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+  Surface surface = _CreateTestSurface(false);
+
+  Renderer.Blit(&config, &surface, (Rect2d) { { 0, 0 }, { 100, 100 } }, (Vector2d) { 9, 12 });
+
+  mu_assert_int_eq(1, config.DirtyCount);
+  mu_assert_int_eq(8, config.DirtyRects[0].Position.X);
+  mu_assert_int_eq(24, config.DirtyRects[0].Size.X);
+  mu_assert_int_eq(4, config.DirtyRects[0].Size.Y);
+}
+
+MU_TEST_SUITE(BlitSuite) {
+  MU_RUN_TEST(Blit__Aligned__MatchesPixelwise);
+  MU_RUN_TEST(Blit__Shifted__MatchesPixelwise);
+  MU_RUN_TEST(Blit__BeyondScreen__IsClipped);
+  MU_RUN_TEST(Blit__BeyondSurface__IsClipped);
+  MU_RUN_TEST(Blit__Always__InvalidatesClippedArea);
+}
+
+
+
+// Glyph cache
+
+static Font _Font;
+static GlyphCache _Cache;
+
+
+static bool _RenderAsciiZMatchesUncached(Vector2d position, char *text) {
+  VgaConfig actual = _CreateTestConfig(_Backbuffer);
+  VgaConfig expected = _CreateTestConfig(_Expected);
+  _FillPlanes(_Backbuffer, 0x3);
+  _FillPlanes(_Expected, 0x3);
+
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Cached", false);
+  Renderer.RenderAsciiZ(&expected, position, text, &_Font, 0xc);
+  Renderer.EnableGlyphCache(&_Font, &_Cache);
+  Renderer.RenderAsciiZ(&actual, position, text, &_Font, 0xc);
+
+  for (U32 index = 0; index < sizeof(_Backbuffer); index++)
+    if (_Backbuffer[index] != _Expected[index])
+      return false;
+
+  return true;
+}
+
+
+MU_TEST(GlyphCache__RenderAsciiZ__MatchesUncached) {
+  for (U16 x = 0; x < 8; x++)
+    mu_check(_RenderAsciiZMatchesUncached((Vector2d) { x, 4 }, "Hi, Wq!"));
+}
+
+MU_TEST(GlyphCache__Clipped__MatchesUncached) {
+  mu_check(_RenderAsciiZMatchesUncached((Vector2d) { 35, TEST_HEIGHT - 5 }, "clipped text"));
+}
+
+MU_TEST(GlyphCache__FirstDraw__BuildsUsedOffsetsOnly) {
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Cached", true);
+  Renderer.EnableGlyphCache(&_Font, &_Cache);
+  mu_assert_int_eq(0, _Cache.BuiltOffsets);
+
+  // Monospace glyphs are 9 pixels apart, so the offsets are 3 and 4
+  Renderer.RenderAsciiZ(&config, (Vector2d) { 3, 0 }, "ab", &_Font, 1);
+  mu_assert_int_eq((1 << 3) | (1 << 4), _Cache.BuiltOffsets);
+}
+
+MU_TEST(GlyphCache__RenderFont__DetachesCache) {
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Cached", false);
+  Renderer.EnableGlyphCache(&_Font, &_Cache);
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Cached", false);
+
+  mu_check(_Font.Cache == null);
+}
+
+MU_TEST_SUITE(GlyphCacheSuite) {
+  MU_RUN_TEST(GlyphCache__RenderAsciiZ__MatchesUncached);
+  MU_RUN_TEST(GlyphCache__Clipped__MatchesUncached);
+  MU_RUN_TEST(GlyphCache__FirstDraw__BuildsUsedOffsetsOnly);
+  MU_RUN_TEST(GlyphCache__RenderFont__DetachesCache);
+}
+
+
+
+// Text runs
+
+static bool _RenderAsciiZMatchesPerChar(Vector2d position, char *text, bool clip) {
+  VgaConfig actual = _CreateTestConfig(_Backbuffer);
+  VgaConfig expected = _CreateTestConfig(_Expected);
+  _FillPlanes(_Backbuffer, 0x3);
+  _FillPlanes(_Expected, 0x3);
+
+  if (clip) {
+    Renderer.PushClip(&actual, (Vector2d) { 13, 2 }, (Vector2d) { 30, 5 });
+    Renderer.PushClip(&expected, (Vector2d) { 13, 2 }, (Vector2d) { 30, 5 });
+  }
+
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Runs", false);
+  Renderer.RenderAsciiZ(&actual, position, text, &_Font, 0xa);
+
+  U16 offset = 0;
+  for (char *textPtr = text; *textPtr; textPtr++) {
+    const RenderChar *glyph = Renderer.GetGlyph(&_Font, *textPtr);
+    offset += Renderer.RenderChar(&expected, (Vector2d) { position.X + offset, position.Y }, glyph, 0xa) + _Font.CharSpacing;
+  }
+
+  return _BuffersMatch();
+}
+
+
+MU_TEST(TextRun__AnyOffset__MatchesPerChar) {
+  for (U16 x = 0; x < 8; x++)
+    mu_check(_RenderAsciiZMatchesPerChar((Vector2d) { x, 3 }, "Run, Wq!", false));
+}
+
+MU_TEST(TextRun__BeyondScreen__MatchesPerChar) {
+  mu_check(_RenderAsciiZMatchesPerChar((Vector2d) { 37, TEST_HEIGHT - 6 }, "off the edge", false));
+}
+
+MU_TEST(TextRun__Clipped__MatchesPerChar) {
+  for (U16 x = 5; x < 21; x++)
+    mu_check(_RenderAsciiZMatchesPerChar((Vector2d) { x, 0 }, "clip this", true));
+}
+
+MU_TEST(TextRun__Empty__DrawsNothing) {
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+  _FillPlanes(_Backbuffer, 0x3);
+  _FillPlanes(_Expected, 0x3);
+
+  Renderer.RenderAsciiZ(&config, (Vector2d) { 4, 4 }, "", &_Font, 0xa);
+
+  mu_check(_BuffersMatch());
+  mu_assert_int_eq(0, config.DirtyCount);
+}
+
+MU_TEST(TextRun__MissingGlyphs__AreSkipped) {
+  VgaConfig actual = _CreateTestConfig(_Backbuffer);
+  VgaConfig expected = _CreateTestConfig(_Expected);
+  _FillPlanes(_Backbuffer, 0x3);
+  _FillPlanes(_Expected, 0x3);
+
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Runs", false);
+  Renderer.RenderAsciiZ(&actual, (Vector2d) { 5, 3 }, "a\x01" "b\x7f\xff" "c", &_Font, 0xa);
+  Renderer.RenderAsciiZ(&expected, (Vector2d) { 5, 3 }, "abc", &_Font, 0xa);
+
+  mu_check(_BuffersMatch());
+  mu_check(!Renderer.GetGlyph(&_Font, '\n'));
+}
+
+MU_TEST_SUITE(TextRunSuite) {
+  MU_RUN_TEST(TextRun__AnyOffset__MatchesPerChar);
+  MU_RUN_TEST(TextRun__BeyondScreen__MatchesPerChar);
+  MU_RUN_TEST(TextRun__Clipped__MatchesPerChar);
+  MU_RUN_TEST(TextRun__Empty__DrawsNothing);
+  MU_RUN_TEST(TextRun__MissingGlyphs__AreSkipped);
+}
+
+
+
+// Text layout
+
+static TextRun _Runs[8];
+
+
+// Monospace glyphs are 8 pixels wide and 9 pixels apart
+static void _RenderMonospaceFont(void) {
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Layout", true);
+}
+
+
+static bool _RunIs(U32 index, U32 start, U16 length) {
+  return _Runs[index].Start == start && _Runs[index].Length == length;
+}
+
+
+MU_TEST(MeasureText__Text__SumsAdvances) {
+  _RenderMonospaceFont();
+
+  mu_assert_int_eq(27, Renderer.MeasureText(&_Font, "abc", 100));
+  mu_assert_int_eq(18, Renderer.MeasureText(&_Font, "ab\ncd", 100));
+  mu_assert_int_eq(18, Renderer.MeasureText(&_Font, "abcdef", 2));
+  mu_assert_int_eq(0, Renderer.MeasureText(&_Font, "", 100));
+}
+
+MU_TEST(LayoutText__LineBreaks__EndRuns) {
+  _RenderMonospaceFont();
+
+  mu_assert_int_eq(3, Renderer.LayoutText(&_Font, "ab\n\ncd", 100, 200, _Runs, 8));
+  mu_check(_RunIs(0, 0, 2));
+  mu_check(_RunIs(1, 3, 0));
+  mu_check(_RunIs(2, 4, 2));
+  mu_assert_int_eq(18, _Runs[2].Width);
+}
+
+MU_TEST(LayoutText__TrailingLineBreak__AddsEmptyRun) {
+  _RenderMonospaceFont();
+
+  mu_assert_int_eq(2, Renderer.LayoutText(&_Font, "ab\n", 100, 200, _Runs, 8));
+  mu_check(_RunIs(1, 3, 0));
+
+  mu_assert_int_eq(1, Renderer.LayoutText(&_Font, "", 100, 200, _Runs, 8));
+  mu_check(_RunIs(0, 0, 0));
+}
+
+MU_TEST(LayoutText__TooWide__WrapsAtSpace) {
+  _RenderMonospaceFont();
+
+  // Five glyphs fit into 44 pixels
+  mu_assert_int_eq(2, Renderer.LayoutText(&_Font, "ab cd ef", 100, 44, _Runs, 8));
+  mu_check(_RunIs(0, 0, 5));
+  mu_check(_RunIs(1, 6, 2));
+  mu_assert_int_eq(45, _Runs[0].Width);
+}
+
+MU_TEST(LayoutText__LongWord__WrapsWithinWord) {
+  _RenderMonospaceFont();
+
+  mu_assert_int_eq(3, Renderer.LayoutText(&_Font, "abcdefgh", 100, 26, _Runs, 8));
+  mu_check(_RunIs(0, 0, 3));
+  mu_check(_RunIs(1, 3, 3));
+  mu_check(_RunIs(2, 6, 2));
+
+  // Each line takes at least one glyph
+  mu_assert_int_eq(2, Renderer.LayoutText(&_Font, "ab", 100, 1, _Runs, 8));
+}
+
+MU_TEST(LayoutText__RunsFull__Stops) {
+  _RenderMonospaceFont();
+
+  mu_assert_int_eq(2, Renderer.LayoutText(&_Font, "a\nb\nc\nd", 100, 200, _Runs, 2));
+  mu_check(_RunIs(1, 2, 1));
+}
+
+MU_TEST_SUITE(TextLayoutSuite) {
+  MU_RUN_TEST(MeasureText__Text__SumsAdvances);
+  MU_RUN_TEST(LayoutText__LineBreaks__EndRuns);
+  MU_RUN_TEST(LayoutText__TrailingLineBreak__AddsEmptyRun);
+  MU_RUN_TEST(LayoutText__TooWide__WrapsAtSpace);
+  MU_RUN_TEST(LayoutText__LongWord__WrapsWithinWord);
+  MU_RUN_TEST(LayoutText__RunsFull__Stops);
+}
+
+
+
+// Packed fonts
+
+static U8 _PackedImage[sizeof(PackedFontHeader) + sizeof(Font)] __attribute__((aligned(4)));
+static PackedFont _PackedFont;
+
+
+static U32 _PackTestFont(bool monospace) {
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Packed", monospace);
+
+  return Renderer.PackFont(&_Font, _PackedImage, sizeof(_PackedImage));
+}
+
+
+static bool _RenderPackedMatchesFont(Vector2d position, char *text, bool monospace) {
+  VgaConfig actual = _CreateTestConfig(_Backbuffer);
+  VgaConfig expected = _CreateTestConfig(_Expected);
+  _FillPlanes(_Backbuffer, 0x3);
+  _FillPlanes(_Expected, 0x3);
+
+  U32 size = _PackTestFont(monospace);
+  if (!Renderer.LoadPackedFont(&_PackedFont, _PackedImage, size))
+    return false;
+
+  Renderer.RenderAsciiZ(&expected, position, text, &_Font, 0xc);
+  Renderer.RenderPackedAsciiZ(&actual, position, text, &_PackedFont, 0xc);
+
+  return _BuffersMatch();
+}
+
+
+// A font with a single glyph ('!') that is wider and taller than 8 pixels
+static struct {
+  PackedFontHeader Header;
+  PackedGlyph Glyphs[2];
+  U8 Bitmaps[24];
+} __attribute__((aligned(4))) _WideFont = {
+  .Header = {
+    .Magic = PACKED_FONT_MAGIC,
+    .Height = 14,
+    .LineSpacing = 1,
+    .GlyphCount = 2,
+    .BitmapSize = 24
+  },
+  .Glyphs = {
+    { .Advance = 4 },
+    { .Offset = 0, .Width = 12, .Advance = 13, .Top = 1, .RowCount = 12 }
+  },
+  .Bitmaps = {
+    0xff, 0xf0, 0x80, 0x10, 0xc0, 0x30, 0xa0, 0x50,
+    0x90, 0x90, 0x89, 0x10, 0x86, 0x10, 0x89, 0x10,
+    0x90, 0x90, 0xa0, 0x50, 0xc0, 0x30, 0xff, 0xf0
+  }
+};
+
+
+// Set the pixels of the wide glyph one by one
+static void _RenderWideGlyphPixelwise(VgaConfig *config, Vector2d position, U8 color) {
+  const U16 bytesPerRow = config->Resolution.X / 8;
+  const U32 bytesPerPlane = bytesPerRow * config->Resolution.Y;
+  const PackedGlyph *glyph = &_WideFont.Glyphs[1];
+
+  for (U16 row = 0; row < glyph->RowCount; row++)
+    for (U16 column = 0; column < glyph->Width; column++) {
+      U16 x = position.X + column;
+      U16 y = position.Y + glyph->Top + row;
+      if (!(_WideFont.Bitmaps[row * 2 + column / 8] & (0x80 >> (column & 7))) || x >= config->Resolution.X || y >= config->Resolution.Y)
+	continue;
+
+      for (U8 plane = 0; plane < config->PlaneCount; plane++) {
+	U8 *destination = (U8*)config->Backbuffer + (plane * bytesPerPlane) + (y * bytesPerRow) + (x / 8);
+	if (color & (1 << plane))
+	  *destination |= 0x80 >> (x & 7);
+	else
+	  *destination &= ~(0x80 >> (x & 7));
+      }
+    }
+}
+
+
+static bool _RenderWideGlyphMatches(Vector2d position) {
+  VgaConfig actual = _CreateTestConfig(_Backbuffer);
+  VgaConfig expected = _CreateTestConfig(_Expected);
+  _FillPlanes(_Backbuffer, 0x5);
+  _FillPlanes(_Expected, 0x5);
+
+  if (!Renderer.LoadPackedFont(&_PackedFont, &_WideFont, sizeof(_WideFont)))
+    return false;
+
+  // The space only advances
+  Renderer.RenderPackedAsciiZ(&actual, position, " !", &_PackedFont, 0xa);
+  _RenderWideGlyphPixelwise(&expected, (Vector2d) { position.X + 4, position.Y }, 0xa);
+
+  return _BuffersMatch();
+}
+
+
+MU_TEST(PackFont__Font__IsSmallerThanFont) {
+  U32 size = _PackTestFont(false);
+
+  mu_check(size > 0);
+  mu_check(size < sizeof(Font));
+}
+
+MU_TEST(PackFont__SmallCapacity__ReturnsZero) {
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Packed", false);
+
+  mu_assert_int_eq(0, Renderer.PackFont(&_Font, _PackedImage, sizeof(PackedFontHeader)));
+  mu_assert_int_eq(0, Renderer.PackFont(&_Font, _PackedImage, 600));
+}
+
+MU_TEST(LoadPackedFont__Malformed__ReturnsFalse) {
+  U32 size = _PackTestFont(false);
+  PackedFontHeader *header = (PackedFontHeader*)_PackedImage;
+  PackedGlyph *glyphs = (PackedGlyph*)(header + 1);
+
+  mu_check(Renderer.LoadPackedFont(&_PackedFont, _PackedImage, size));
+  mu_check(!Renderer.LoadPackedFont(&_PackedFont, _PackedImage, size - 1));
+
+  header->Magic = 0;
+  mu_check(!Renderer.LoadPackedFont(&_PackedFont, _PackedImage, size));
+  header->Magic = PACKED_FONT_MAGIC;
+
+  header->Height = PACKED_FONT_MAX_SIZE + 1;
+  mu_check(!Renderer.LoadPackedFont(&_PackedFont, _PackedImage, size));
+  header->Height = 8;
+
+  glyphs[10].Offset = header->BitmapSize;
+  glyphs[10].RowCount = 1;
+  mu_check(!Renderer.LoadPackedFont(&_PackedFont, _PackedImage, size));
+}
+
+MU_TEST(RenderPackedAsciiZ__PackedFont__MatchesFont) {
+  for (U16 x = 0; x < 8; x++) {
+    mu_check(_RenderPackedMatchesFont((Vector2d) { x, 3 }, "Hi, Wq!", false));
+    mu_check(_RenderPackedMatchesFont((Vector2d) { x, 3 }, "Hi, Wq!", true));
+  }
+}
+
+MU_TEST(RenderPackedAsciiZ__Clipped__MatchesFont) {
+  mu_check(_RenderPackedMatchesFont((Vector2d) { 35, TEST_HEIGHT - 5 }, "clipped text", false));
+}
+
+MU_TEST(RenderPackedAsciiZ__WideGlyph__MatchesPixelwise) {
+  for (U16 x = 0; x < 8; x++)
+    mu_check(_RenderWideGlyphMatches((Vector2d) { 9 + x, 0 }));
+
+  mu_check(_RenderWideGlyphMatches((Vector2d) { TEST_WIDTH - 10, 4 }));
+}
+
+MU_TEST_SUITE(PackedFontSuite) {
+  MU_RUN_TEST(PackFont__Font__IsSmallerThanFont);
+  MU_RUN_TEST(PackFont__SmallCapacity__ReturnsZero);
+  MU_RUN_TEST(LoadPackedFont__Malformed__ReturnsFalse);
+  MU_RUN_TEST(RenderPackedAsciiZ__PackedFont__MatchesFont);
+  MU_RUN_TEST(RenderPackedAsciiZ__Clipped__MatchesFont);
+  MU_RUN_TEST(RenderPackedAsciiZ__WideGlyph__MatchesPixelwise);
+}
+
+
+
+// Clipping
+
+#define CLIP_BACKGROUND 0x9
+
+static const Rect2d _TestClip = { { 13, 3 }, { 30, 9 } };
+
+
+// Reset every pixel outside of the test clip to the background
+static void _ClearOutsideClip(U8 *buffer) {
+  const U16 bytesPerRow = TEST_WIDTH / 8;
+
+  for (U8 plane = 0; plane < TEST_PLANES; plane++)
+    for (U16 y = 0; y < TEST_HEIGHT; y++)
+      for (U16 x = 0; x < TEST_WIDTH; x++) {
+	if (x >= _TestClip.Position.X && x < _TestClip.Position.X + _TestClip.Size.X
+	    && y >= _TestClip.Position.Y && y < _TestClip.Position.Y + _TestClip.Size.Y)
+	  continue;
+
+	U8 *byte = buffer + plane * bytesPerRow * TEST_HEIGHT + y * bytesPerRow + (x >> 3);
+	if (CLIP_BACKGROUND & (1 << plane))
+	  *byte |= 0x80 >> (x & 7);
+	else
+	  *byte &= ~(0x80 >> (x & 7));
+      }
+}
+
+
+// Draw with and without the test clip; the clipped result has to match
+// the unclipped one inside of the clip and keep the background outside
+static bool _ClippedMatches(void (*draw)(VgaConfig *config)) {
+  VgaConfig actual = _CreateTestConfig(_Backbuffer);
+  VgaConfig expected = _CreateTestConfig(_Expected);
+  _FillPlanes(_Backbuffer, CLIP_BACKGROUND);
+  _FillPlanes(_Expected, CLIP_BACKGROUND);
+
+  Renderer.PushClip(&actual, _TestClip.Position, _TestClip.Size);
+  draw(&actual);
+  draw(&expected);
+  _ClearOutsideClip(_Expected);
+
+  return _BuffersMatch();
+}
+
+
+static void _DrawFilledRects(VgaConfig *config) {
+  Renderer.RenderFilledRect(config, (Vector2d) { 5, 1 }, (Vector2d) { 50, 4 }, 0x6);
+  Renderer.RenderFilledRect(config, (Vector2d) { 40, 8 }, (Vector2d) { 30, 30 }, 0x3);
+}
+
+static void _DrawRects(VgaConfig *config) {
+  Renderer.RenderRect(config, (Vector2d) { 10, 1 }, (Vector2d) { 20, 9 }, 2, 0x6);
+  Renderer.RenderRect(config, (Vector2d) { 35, 5 }, (Vector2d) { 20, 20 }, 3, 0x4);
+}
+
+static void _DrawText(VgaConfig *config) {
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Clipped", false);
+  Renderer.RenderAsciiZ(config, (Vector2d) { 9, 0 }, "Clip it", &_Font, 0x6);
+  Renderer.RenderAsciiZ(config, (Vector2d) { 1, 7 }, "again, cached", &_Font, 0x2);
+}
+
+static void _DrawCachedText(VgaConfig *config) {
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Clipped", false);
+  Renderer.EnableGlyphCache(&_Font, &_Cache);
+  Renderer.RenderAsciiZ(config, (Vector2d) { 9, 0 }, "Clip it", &_Font, 0x6);
+  Renderer.RenderAsciiZ(config, (Vector2d) { 1, 7 }, "again, cached", &_Font, 0x2);
+}
+
+static void _DrawSurface(VgaConfig *config) {
+  Surface surface = _CreateTestSurface(true);
+  Rect2d whole = { { 0, 0 }, { SURFACE_WIDTH, SURFACE_HEIGHT } };
+
+  Renderer.Blit(config, &surface, whole, (Vector2d) { 9, 1 });
+  Renderer.Blit(config, &surface, whole, (Vector2d) { 30, 8 });
+}
+
+static void _DrawScreen(VgaConfig *config) {
+  Renderer.FillScreen(config, 0xe);
+}
+
+
+MU_TEST(PushClip__Nested__IntersectsWithOuter) {
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+
+  mu_check(Renderer.PushClip(&config, (Vector2d) { 8, 2 }, (Vector2d) { 100, 6 }));
+  mu_check(Renderer.PushClip(&config, (Vector2d) { 4, 4 }, (Vector2d) { 20, 20 }));
+
+  mu_assert_int_eq(2, config.ClipDepth);
+  mu_assert_int_eq(8, config.ClipRects[1].Position.X);
+  mu_assert_int_eq(4, config.ClipRects[1].Position.Y);
+  mu_assert_int_eq(16, config.ClipRects[1].Size.X);
+  mu_assert_int_eq(4, config.ClipRects[1].Size.Y);
+
+  Renderer.PopClip(&config);
+  mu_assert_int_eq(1, config.ClipDepth);
+  mu_assert_int_eq(56, config.ClipRects[0].Size.X);
+}
+
+MU_TEST(PushClip__StackFull__ReturnsFalse) {
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+
+  for (U16 depth = 0; depth < VGA_CLIP_DEPTH; depth++)
+    mu_check(Renderer.PushClip(&config, (Vector2d) { depth, 0 }, (Vector2d) { TEST_WIDTH, TEST_HEIGHT }));
+
+  mu_check(!Renderer.PushClip(&config, (Vector2d) { 0, 0 }, (Vector2d) { 1, 1 }));
+  mu_assert_int_eq(VGA_CLIP_DEPTH, config.ClipDepth);
+}
+
+MU_TEST(PushClip__Disjoint__HidesEverything) {
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+  _FillPlanes(_Backbuffer, 0x0);
+
+  Renderer.PushClip(&config, (Vector2d) { 0, 0 }, (Vector2d) { 8, 8 });
+  Renderer.PushClip(&config, (Vector2d) { 16, 8 }, (Vector2d) { 8, 8 });
+  Renderer.FillScreen(&config, 0xf);
+  Renderer.RenderFilledRect(&config, (Vector2d) { 0, 0 }, (Vector2d) { 30, 30 }, 0xf);
+
+  mu_assert_int_eq(0, config.DirtyCount);
+  for (U32 index = 0; index < sizeof(_Backbuffer); index++)
+    mu_check(_Backbuffer[index] == 0);
+}
+
+MU_TEST(PopClip__Empty__KeepsDepth) {
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+
+  Renderer.PopClip(&config);
+  mu_assert_int_eq(0, config.ClipDepth);
+}
+
+MU_TEST(Clip__Primitives__DrawInsideOnly) {
+  mu_check(_ClippedMatches(_DrawFilledRects));
+  mu_check(_ClippedMatches(_DrawRects));
+  mu_check(_ClippedMatches(_DrawText));
+  mu_check(_ClippedMatches(_DrawCachedText));
+  mu_check(_ClippedMatches(_DrawSurface));
+  mu_check(_ClippedMatches(_DrawScreen));
+}
+
+MU_TEST(Clip__FillScreen__InvalidatesClip) {
+  VgaConfig config = _CreateTestConfig(_Backbuffer);
+
+  Renderer.PushClip(&config, (Vector2d) { 16, 2 }, (Vector2d) { 16, 5 });
+  Renderer.FillScreen(&config, 1);
+
+  mu_assert_int_eq(1, config.DirtyCount);
+  mu_assert_int_eq(16, config.DirtyRects[0].Position.X);
+  mu_assert_int_eq(2, config.DirtyRects[0].Position.Y);
+  mu_assert_int_eq(16, config.DirtyRects[0].Size.X);
+  mu_assert_int_eq(5, config.DirtyRects[0].Size.Y);
+}
+
+MU_TEST_SUITE(ClipSuite) {
+  MU_RUN_TEST(PushClip__Nested__IntersectsWithOuter);
+  MU_RUN_TEST(PushClip__StackFull__ReturnsFalse);
+  MU_RUN_TEST(PushClip__Disjoint__HidesEverything);
+  MU_RUN_TEST(PopClip__Empty__KeepsDepth);
+  MU_RUN_TEST(Clip__Primitives__DrawInsideOnly);
+  MU_RUN_TEST(Clip__FillScreen__InvalidatesClip);
+}
+
+
+
+// Chunky backbuffers
+
+static U8 _Chunky[TEST_WIDTH * TEST_HEIGHT];
+
+
+static VgaConfig _CreateChunkyConfig(void) {
+  VgaConfig config = _CreateTestConfig(_Chunky);
+  config.Format = VgaChunky;
+
+  return config;
+}
+
+
+// Draw the same thing into a planar and a chunky backbuffer, then
+// compare the planar one with the converted chunky one
+static bool _ChunkyMatchesPlanar(void (*draw)(VgaConfig *config), bool clip) {
+  VgaConfig planar = _CreateTestConfig(_Expected);
+  VgaConfig chunky = _CreateChunkyConfig();
+  _FillPlanes(_Expected, 0x9);
+  for (U32 index = 0; index < sizeof(_Chunky); index++)
+    _Chunky[index] = 0x9;
+
+  if (clip) {
+    Renderer.PushClip(&planar, (Vector2d) { 11, 3 }, (Vector2d) { 37, 9 });
+    Renderer.PushClip(&chunky, (Vector2d) { 11, 3 }, (Vector2d) { 37, 9 });
+  }
+
+  draw(&planar);
+  draw(&chunky);
+
+  Renderer.ChunkyToPlanar(&chunky, (Rect2d) { { 0, 0 }, { TEST_WIDTH, TEST_HEIGHT } }, _Backbuffer);
+  if (!_BuffersMatch())
+    return false;
+
+  // Both mark the same regions as changed
+  if (planar.DirtyCount != chunky.DirtyCount)
+    return false;
+
+  for (U16 index = 0; index < planar.DirtyCount; index++)
+    if (planar.DirtyRects[index].Position.X != chunky.DirtyRects[index].Position.X
+	|| planar.DirtyRects[index].Position.Y != chunky.DirtyRects[index].Position.Y
+	|| planar.DirtyRects[index].Size.X != chunky.DirtyRects[index].Size.X
+	|| planar.DirtyRects[index].Size.Y != chunky.DirtyRects[index].Size.Y)
+      return false;
+
+  return true;
+}
+
+
+static void _DrawGlyphs(VgaConfig *config) {
+  Renderer.RenderFont(&_Font, (Bitmap8x8*)FONT_ZX_COURIER_BITMAP, "Chunky", false);
+
+  for (U16 x = 0; x < 8; x++)
+    Renderer.RenderChar(config, (Vector2d) { x * 9 + 2, x }, Renderer.GetGlyph(&_Font, 'a' + x), x + 3);
+}
+
+static void _DrawScrolled(VgaConfig *config) {
+  _DrawSurface(config);
+  Renderer.ScrollRegion(config, (Vector2d) { 6, 1 }, (Vector2d) { 40, 12 }, 3);
+  Renderer.ScrollRegion(config, (Vector2d) { 20, 0 }, (Vector2d) { 30, 16 }, -5);
+}
+
+
+MU_TEST(ChunkyToPlanar__AnyPixels__MatchesPixelwise) {
+  VgaConfig config = _CreateChunkyConfig();
+  for (U32 index = 0; index < sizeof(_Chunky); index++)
+    _Chunky[index] = (U8)(index * 151 + (index >> 3) * 7 + 3);
+
+  for (U32 index = 0; index < sizeof(_Expected); index++)
+    _Expected[index] = 0;
+
+  for (U16 y = 0; y < TEST_HEIGHT; y++)
+    for (U16 x = 0; x < TEST_WIDTH; x++)
+      for (U16 plane = 0; plane < TEST_PLANES; plane++)
+	if (_Chunky[y * TEST_WIDTH + x] & (1 << plane))
+	  _Expected[(plane * (TEST_WIDTH / 8) * TEST_HEIGHT) + (y * (TEST_WIDTH / 8)) + (x >> 3)] |= 0x80 >> (x & 7);
+
+  for (U32 index = 0; index < sizeof(_Backbuffer); index++)
+    _Backbuffer[index] = 0;
+
+  Renderer.ChunkyToPlanar(&config, (Rect2d) { { 0, 0 }, { TEST_WIDTH, TEST_HEIGHT } }, _Backbuffer);
+  mu_check(_BuffersMatch());
+}
+
+MU_TEST(ChunkyToPlanar__Region__ConvertsWholeBytesInside) {
+  VgaConfig config = _CreateChunkyConfig();
+  for (U32 index = 0; index < sizeof(_Chunky); index++)
+    _Chunky[index] = 0xf;
+  for (U32 index = 0; index < sizeof(_Backbuffer); index++)
+    _Backbuffer[index] = 0;
+
+  Renderer.ChunkyToPlanar(&config, (Rect2d) { { 13, 2 }, { 10, 3 } }, _Backbuffer);
+
+  const U16 bytesPerRow = TEST_WIDTH / 8;
+  for (U16 y = 0; y < TEST_HEIGHT; y++)
+    for (U16 byte = 0; byte < bytesPerRow; byte++) {
+      bool inside = y >= 2 && y < 5 && byte >= 1 && byte <= 2;
+      mu_assert_int_eq(inside ? 0xff : 0x00, _Backbuffer[(y * bytesPerRow) + byte]);
+    }
+}
+
+MU_TEST(Chunky__Primitives__MatchPlanar) {
+  mu_check(_ChunkyMatchesPlanar(_DrawFilledRects, false));
+  mu_check(_ChunkyMatchesPlanar(_DrawRects, false));
+  mu_check(_ChunkyMatchesPlanar(_DrawGlyphs, false));
+  mu_check(_ChunkyMatchesPlanar(_DrawText, false));
+  mu_check(_ChunkyMatchesPlanar(_DrawCachedText, false));
+  mu_check(_ChunkyMatchesPlanar(_DrawSurface, false));
+  mu_check(_ChunkyMatchesPlanar(_DrawScreen, false));
+  mu_check(_ChunkyMatchesPlanar(_DrawScrolled, false));
+}
+
+MU_TEST(Chunky__ClippedPrimitives__MatchPlanar) {
+  mu_check(_ChunkyMatchesPlanar(_DrawFilledRects, true));
+  mu_check(_ChunkyMatchesPlanar(_DrawRects, true));
+  mu_check(_ChunkyMatchesPlanar(_DrawGlyphs, true));
+  mu_check(_ChunkyMatchesPlanar(_DrawText, true));
+  mu_check(_ChunkyMatchesPlanar(_DrawCachedText, true));
+  mu_check(_ChunkyMatchesPlanar(_DrawSurface, true));
+  mu_check(_ChunkyMatchesPlanar(_DrawScreen, true));
+  mu_check(_ChunkyMatchesPlanar(_DrawScrolled, true));
+}
+
+MU_TEST_SUITE(ChunkySuite) {
+  MU_RUN_TEST(ChunkyToPlanar__AnyPixels__MatchesPixelwise);
+  MU_RUN_TEST(ChunkyToPlanar__Region__ConvertsWholeBytesInside);
+  MU_RUN_TEST(Chunky__Primitives__MatchPlanar);
+  MU_RUN_TEST(Chunky__ClippedPrimitives__MatchPlanar);
+}
+
+
+
+// Overlays
+
+#define OVERLAY_SCREEN_WIDTH 32
+#define OVERLAY_SCREEN_HEIGHT 8
+
+static U8 _OverlayScreen[OVERLAY_SCREEN_WIDTH * OVERLAY_SCREEN_HEIGHT];
+
+// A 10x2 sprite: a full row and a row with every other pixel
+static const U8 _OverlayMask[] = { 0xff, 0xc0, 0xaa, 0x80 };
+static const VgaSprite _OverlaySprite = { .Size = { 10, 2 }, .Mask = _OverlayMask };
+
+
+// Linear screens are plain memory, so the XOR can be checked on the host
+static VgaConfig _CreateOverlayConfig(void) {
+  for (U32 index = 0; index < sizeof(_OverlayScreen); index++)
+    _OverlayScreen[index] = index & 0xff;
+
+  return (VgaConfig) {
+    .Resolution = { OVERLAY_SCREEN_WIDTH, OVERLAY_SCREEN_HEIGHT },
+    .PlaneCount = 8,
+    .Format = VgaChunky,
+    .ScreenModel = VgaScreenLinear,
+    .ScreenBuffer = _OverlayScreen
+  };
+}
+
+static bool _IsOverlayPixel(Vector2d position, U16 x, U16 y) {
+  if (x < position.X || y < position.Y)
+    return false;
+
+  U16 column = x - position.X;
+  U16 row = y - position.Y;
+  if (column >= _OverlaySprite.Size.X || row >= _OverlaySprite.Size.Y)
+    return false;
+
+  return _OverlayMask[(row * 2) + (column >> 3)] & (0x80 >> (column & 7));
+}
+
+// Check every pixel of the screen against the overlay at a position
+static bool _ScreenShowsOverlay(Vector2d position, U8 color) {
+  for (U16 y = 0; y < OVERLAY_SCREEN_HEIGHT; y++)
+    for (U16 x = 0; x < OVERLAY_SCREEN_WIDTH; x++) {
+      U32 index = (y * OVERLAY_SCREEN_WIDTH) + x;
+      U8 expected = index & 0xff;
+      if (_IsOverlayPixel(position, x, y))
+	expected ^= color;
+
+      if (_OverlayScreen[index] != expected)
+	return false;
+    }
+
+  return true;
+}
+
+static bool _ScreenIsUntouched(void) {
+  for (U32 index = 0; index < sizeof(_OverlayScreen); index++)
+    if (_OverlayScreen[index] != (index & 0xff))
+      return false;
+
+  return true;
+}
+
+
+MU_TEST(ShowOverlay__LinearScreen__XorsSpritePixels) {
+  VgaConfig config = _CreateOverlayConfig();
+  VgaOverlay overlay = { .Sprite = &_OverlaySprite, .Position = { 3, 2 }, .Color = 0x5a };
+
+  mu_check(Renderer.ShowOverlay(&config, &overlay));
+  mu_check(overlay.Visible);
+  mu_assert_int_eq(1, config.OverlayCount);
+  mu_check(_ScreenShowsOverlay(overlay.Position, 0x5a));
+  mu_assert_int_eq(0, config.DirtyCount);
+
+  // Showing it again does not undo it
+  mu_check(Renderer.ShowOverlay(&config, &overlay));
+  mu_check(_ScreenShowsOverlay(overlay.Position, 0x5a));
+}
+
+MU_TEST(HideOverlay__Shown__RestoresScreen) {
+  VgaConfig config = _CreateOverlayConfig();
+  VgaOverlay overlay = { .Sprite = &_OverlaySprite, .Position = { 3, 2 }, .Color = 0x5a };
+
+  Renderer.ShowOverlay(&config, &overlay);
+  Renderer.HideOverlay(&config, &overlay);
+
+  mu_check(!overlay.Visible);
+  mu_assert_int_eq(0, config.OverlayCount);
+  mu_check(_ScreenIsUntouched());
+
+  // Hiding it again changes nothing
+  Renderer.HideOverlay(&config, &overlay);
+  mu_check(_ScreenIsUntouched());
+}
+
+MU_TEST(MoveOverlay__Shown__RestoresOldPosition) {
+  VgaConfig config = _CreateOverlayConfig();
+  VgaOverlay overlay = { .Sprite = &_OverlaySprite, .Position = { 3, 2 }, .Color = 0x5a };
+
+  Renderer.ShowOverlay(&config, &overlay);
+  Renderer.MoveOverlay(&config, &overlay, (Vector2d) { 7, 3 });
+
+  mu_assert_int_eq(7, overlay.Position.X);
+  mu_check(_ScreenShowsOverlay(overlay.Position, 0x5a));
+}
+
+MU_TEST(ShowOverlay__ScreenEdge__SkipsOutsidePixels) {
+  VgaConfig config = _CreateOverlayConfig();
+  Vector2d position = { OVERLAY_SCREEN_WIDTH - 4, OVERLAY_SCREEN_HEIGHT - 1 };
+  VgaOverlay overlay = { .Sprite = &_OverlaySprite, .Position = position, .Color = 0xff };
+
+  mu_check(Renderer.ShowOverlay(&config, &overlay));
+  mu_check(_ScreenShowsOverlay(position, 0xff));
+
+  Renderer.HideOverlay(&config, &overlay);
+  mu_check(_ScreenIsUntouched());
+}
+
+MU_TEST(ShowOverlay__NoScreenOrFull__ReturnsFalse) {
+  VgaConfig config = _CreateOverlayConfig();
+  VgaOverlay overlays[VGA_OVERLAY_COUNT + 1];
+
+  for (U16 index = 0; index <= VGA_OVERLAY_COUNT; index++)
+    overlays[index] = (VgaOverlay) { .Sprite = &_OverlaySprite, .Position = { index, 0 }, .Color = 1 };
+
+  for (U16 index = 0; index < VGA_OVERLAY_COUNT; index++)
+    mu_check(Renderer.ShowOverlay(&config, &overlays[index]));
+  mu_check(!Renderer.ShowOverlay(&config, &overlays[VGA_OVERLAY_COUNT]));
+  mu_check(!overlays[VGA_OVERLAY_COUNT].Visible);
+
+  config = (VgaConfig) { .Resolution = { 640, 480 } };
+  overlays[0].Visible = false;
+  mu_check(!Renderer.ShowOverlay(&config, &overlays[0]));
+}
+
+MU_TEST_SUITE(OverlaySuite) {
+  MU_RUN_TEST(ShowOverlay__LinearScreen__XorsSpritePixels);
+  MU_RUN_TEST(HideOverlay__Shown__RestoresScreen);
+  MU_RUN_TEST(MoveOverlay__Shown__RestoresOldPosition);
+  MU_RUN_TEST(ShowOverlay__ScreenEdge__SkipsOutsidePixels);
+  MU_RUN_TEST(ShowOverlay__NoScreenOrFull__ReturnsFalse);
+}
+
+
+
+int main(void) {
+  // Verify, that the module is properly set up
+  MU_RUN_SUITE(CModuleSetup);
+
+  // Character bitmap renderer
+  MU_RUN_SUITE(RenderCharBitmap);
+  MU_RUN_SUITE(RenderFont);
+
+  // Character blitting
+  MU_RUN_SUITE(RenderCharBlit);
+  MU_RUN_SUITE(GlyphCacheSuite);
+  MU_RUN_SUITE(TextRunSuite);
+  MU_RUN_SUITE(PackedFontSuite);
+  MU_RUN_SUITE(TextLayoutSuite);
+
+  // Rect filling
+  MU_RUN_SUITE(RenderFilledRectSuite);
+
+  // Scrolling
+  MU_RUN_SUITE(ScrollRegionSuite);
+  MU_RUN_SUITE(PageFlippingSuite);
+
+  // Blitting
+  MU_RUN_SUITE(BlitSuite);
+
+  // Clipping
+  MU_RUN_SUITE(ClipSuite);
+
+  // Chunky backbuffers
+  MU_RUN_SUITE(ChunkySuite);
+
+  // Overlays
+  MU_RUN_SUITE(OverlaySuite);
+  
+  MU_REPORT();
+  return MU_EXIT_CODE;
+}
@@ -0,0 +1,281 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+// Host tool that renders fonts at build time
+//
+// Usage: FontBaker <font>[:Monospace][:Cached|:Packed]...
+//
+// Prints a C source file with one const Font per argument, named
+// BAKED_FONT(font) (or BAKED_MONOSPACE_FONT(font)). Cached fonts get a
+// glyph cache of their own (in the BSS, the font itself stays read-only).
+// Packed fonts are const PackedFonts along with their image instead,
+// named BAKED_PACKED_FONT(font) (or BAKED_MONOSPACE_PACKED_FONT(font)).
+
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../Include/GfxTk.h"
+#include "../Include/Font_CompressionShort.h"
+#include "../Include/Font_CompressionSquareShort.h"
+#include "../Include/Font_CompressionSquareTall.h"
+#include "../Include/Font_CompressionTall.h"
+#include "../Include/Font_Envious.h"
+#include "../Include/Font_EnviousBold.h"
+#include "../Include/Font_EnviousItalic.h"
+#include "../Include/Font_EnviousSerif.h"
+#include "../Include/Font_EnviousSerifBold.h"
+#include "../Include/Font_Forgotten.h"
+#include "../Include/Font_ForgottenBold.h"
+#include "../Include/Font_Pixie.h"
+#include "../Include/Font_PixieBell.h"
+#include "../Include/Font_PixieBellStretch.h"
+#include "../Include/Font_PixieBold.h"
+#include "../Include/Font_PixieDigital.h"
+#include "../Include/Font_Widget.h"
+#include "../Include/Font_WidgetBold.h"
+#include "../Include/Font_ZXCourier.h"
+
+
+import(Renderer);
+
+
+// Must match the names produced by BAKED_FONT
+#define _SYMBOL_PREFIX "GfxTk_BakedFont_"
+
+#define _FONT_NAME(fontId) { #fontId, fontId }
+
+
+static const struct {
+  const char *Name;
+  FontId Id;
+} _FontNames[] = {
+  _FONT_NAME(CompressionShort),
+  _FONT_NAME(CompressionSquareShort),
+  _FONT_NAME(CompressionSquareTall),
+  _FONT_NAME(CompressionTall),
+  _FONT_NAME(Envious),
+  _FONT_NAME(EnviousBold),
+  _FONT_NAME(EnviousItalic),
+  _FONT_NAME(EnviousSerif),
+  _FONT_NAME(EnviousSerifBold),
+  _FONT_NAME(Forgotten),
+  _FONT_NAME(ForgottenBold),
+  _FONT_NAME(Pixie),
+  _FONT_NAME(PixieBell),
+  _FONT_NAME(PixieBellStretch),
+  _FONT_NAME(PixieBold),
+  _FONT_NAME(PixieDigital),
+  _FONT_NAME(Widget),
+  _FONT_NAME(WidgetBold),
+  _FONT_NAME(ZxCourier)
+};
+
+
+// The raw bitmaps only live in the baker, the kernel links the baked fonts
+static Bitmap8x8* _GetFontBitmap(FontId fontId) {
+  switch (fontId) {
+  case CompressionShort:
+    return (Bitmap8x8*)FONT_COMPRESSION_SHORT_BITMAP;
+
+  case CompressionSquareShort:
+    return (Bitmap8x8*)FONT_COMPRESSION_SQUARE_SHORT_BITMAP;
+
+  case CompressionSquareTall:
+    return (Bitmap8x8*)FONT_COMPRESSION_SQUARE_TALL_BITMAP;
+
+  case CompressionTall:
+    return (Bitmap8x8*)FONT_COMPRESSION_TALL_BITMAP;
+
+  case EnviousBold:
+    return (Bitmap8x8*)FONT_ENVIOUS_BOLD_BITMAP;
+
+  case Envious:
+    return (Bitmap8x8*)FONT_ENVIOUS_BITMAP;
+
+  case EnviousItalic:
+    return (Bitmap8x8*)FONT_ENVIOUS_ITALIC_BITMAP;
+
+  case EnviousSerif:
+    return (Bitmap8x8*)FONT_ENVIOUS_SERIF_BITMAP;
+    
+  case EnviousSerifBold:
+    return (Bitmap8x8*)FONT_ENVIOUS_SERIF_BOLD_BITMAP;
+
+  case Forgotten:
+    return (Bitmap8x8*)FONT_FORGOTTEN_BITMAP;
+
+  case ForgottenBold:
+    return (Bitmap8x8*)FONT_FORGOTTEN_BOLD_BITMAP;
+
+  case Pixie:
+    return (Bitmap8x8*)FONT_PIXIE_BITMAP;
+    
+  case PixieBell:
+    return (Bitmap8x8*)FONT_PIXIE_BELL_BITMAP;
+    
+  case PixieBellStretch:
+    return (Bitmap8x8*)FONT_PIXIE_BELL_STRETCH_BITMAP;
+    
+  case PixieBold:
+    return (Bitmap8x8*)FONT_PIXIE_BOLD_BITMAP;
+    
+  case PixieDigital:
+    return (Bitmap8x8*)FONT_PIXIE_DIGITAL_BITMAP;
+    
+  case Widget:
+    return (Bitmap8x8*)FONT_WIDGET_BITMAP;
+    
+  case WidgetBold:
+    return (Bitmap8x8*)FONT_WIDGET_BOLD_BITMAP;
+    
+  case ZxCourier:
+    return (Bitmap8x8*)FONT_ZX_COURIER_BITMAP;
+
+  default:
+    return null;
+  }
+}
+
+
+static FontId _GetFontId(const char *name, size_t length) {
+  for (size_t index = 0; index < sizeof(_FontNames) / sizeof(_FontNames[0]); index++)
+    if (strlen(_FontNames[index].Name) == length && !strncmp(_FontNames[index].Name, name, length))
+      return _FontNames[index].Id;
+
+  return Undefined;
+}
+
+
+static bool _HasOption(const char *spec, const char *option) {
+  for (const char *next = strchr(spec, ':'); next; next = strchr(next + 1, ':'))
+    if (!strncmp(next + 1, option, strlen(option)) && (next[1 + strlen(option)] == ':' || !next[1 + strlen(option)]))
+      return true;
+
+  return false;
+}
+
+
+static void _PrintFont(const Font *font, const char *symbol, bool cached) {
+  if (cached)
+    printf("static GlyphCache %s_Cache;\n\n", symbol);
+
+  printf("const Font %s = {\n", symbol);
+  printf("  .Name = \"%s\",\n", font->Name);
+  printf("  .CharSpacing = %u,\n", font->CharSpacing);
+  printf("  .LineSpacing = %u,\n", font->LineSpacing);
+  printf("  .Char = {\n");
+
+  for (U8 charIndex = 0; charIndex < FONT_CHAR_COUNT; charIndex++) {
+    const RenderChar *glyph = &font->Char[charIndex];
+
+    printf("    { { %u, %u }, { ", glyph->Size.X, glyph->Size.Y);
+    for (U8 rowIndex = 0; rowIndex < sizeof(Bitmap8x8); rowIndex++)
+      printf("%s0x%02x", rowIndex ? ", " : "", glyph->Bitmap[rowIndex]);
+    printf(" } }, // '%c'\n", charIndex + 32);
+  }
+
+  printf("  },\n");
+  if (cached)
+    printf("  .Cache = &%s_Cache\n", symbol);
+  else
+    printf("  .Cache = null\n");
+  printf("};\n\n\n");
+}
+
+
+static void _PrintPackedFont(const Font *font, const char *symbol) {
+  static U8 image[sizeof(PackedFontHeader) + sizeof(Font)];
+  const U32 size = Renderer.PackFont(font, image, sizeof(image));
+
+  printf("static const U8 %s_Image[] __attribute__((aligned(4))) = {", symbol);
+  for (U32 index = 0; index < size; index++)
+    printf("%s0x%02x", index % 12 ? ", " : (index ? ",\n  " : "\n  "), image[index]);
+  printf("\n};\n\n");
+
+  const PackedFontHeader *header = (PackedFontHeader*)image;
+  const U32 tableSize = sizeof(PackedFontHeader) + header->GlyphCount * sizeof(PackedGlyph);
+
+  printf("const PackedFont %s = {\n", symbol);
+  printf("  .Height = %u,\n", header->Height);
+  printf("  .LineSpacing = %u,\n", header->LineSpacing);
+  printf("  .GlyphCount = %u,\n", header->GlyphCount);
+  printf("  .Glyphs = (const PackedGlyph*)(%s_Image + %u),\n", symbol, (unsigned)sizeof(PackedFontHeader));
+  printf("  .Bitmaps = %s_Image + %u\n", symbol, tableSize);
+  printf("};\n\n\n");
+}
+
+
+static size_t _GetNameLength(const char *spec) {
+  const char *options = strchr(spec, ':');
+
+  return options ? (size_t)(options - spec) : strlen(spec);
+}
+
+
+int main(int argc, char **argv) {
+  // Check all fonts before printing anything
+  for (int argIndex = 1; argIndex < argc; argIndex++) {
+    const size_t nameLength = _GetNameLength(argv[argIndex]);
+
+    if (_GetFontId(argv[argIndex], nameLength) == Undefined) {
+      fprintf(stderr, "FontBaker: unknown font '%.*s'\n", (int)nameLength, argv[argIndex]);
+      return 1;
+    }
+  }
+
+  printf("// Generated by FontBaker, do not edit\n\n");
+  printf("#include \"../Include/GfxTk.h\"\n\n\n");
+
+  static Font font;
+
+  for (int argIndex = 1; argIndex < argc; argIndex++) {
+    const char *spec = argv[argIndex];
+    const size_t nameLength = _GetNameLength(spec);
+    const FontId fontId = _GetFontId(spec, nameLength);
+
+    const bool monospace = _HasOption(spec, "Monospace");
+    char name[FONT_NAME_LENGTH] = { };
+    strncpy(name, spec, nameLength < FONT_NAME_LENGTH - 1 ? nameLength : FONT_NAME_LENGTH - 1);
+
+    memset(&font, 0, sizeof(font));
+    Renderer.RenderFont(&font, _GetFontBitmap(fontId), name, monospace);
+
+    const bool packed = _HasOption(spec, "Packed");
+    char symbol[128];
+    snprintf(symbol, sizeof(symbol), _SYMBOL_PREFIX "%s%s%s", name, monospace ? "Monospace" : "", packed ? "Packed" : "");
+
+    if (packed)
+      _PrintPackedFont(&font, symbol);
+    else
+      _PrintFont(&font, symbol, _HasOption(spec, "Cached"));
+  }
+
+  return 0;
+}
@@ -72,8 +72,56 @@ module(GenericList) {
 };
 
 
+// Identifies an entry of a priority queue
+typedef U32 QueueHandle;
+
+// Returned if an entry could not be queued
+#define QUEUE_INVALID_HANDLE 0xffffffff
+
+
+typedef struct QueueEntry {
+  // The priority of the entry (lowest key is dequeued first)
+  U32 Key;
+  void *Payload;
+
+  // The index of the entry in the heap order; for unused entries, this
+  // is the handle of the next free entry instead.
+  U32 Position;
+} QueueEntry;
+
+
+
+typedef struct PriorityQueue {
+  HeapArea* Heap;
+
+  // Entry storage (the index of an entry is its handle)
+  QueueEntry* Entries;
+  // Binary min-heap of entry handles, ordered by key
+  QueueHandle* Order;
+
+  U32 Capacity;
+  U32 Count;
+
+  // The head of the list of unused entries
+  QueueHandle NextFree;
+} PriorityQueue;
+
+
+
+module(GenericPriorityQueue) {
+  PriorityQueue* (*Create)(HeapArea* heap, U32 capacity);
+  void (*Dispose)(PriorityQueue* this);
+  QueueHandle (*Push)(PriorityQueue* this, U32 key, void* payload);
+  void* (*PopMin)(PriorityQueue* this, U32* key);
+  void* (*PeekMin)(PriorityQueue* this, U32* key);
+  bool (*DecreaseKey)(PriorityQueue* this, QueueHandle handle, U32 key);
+  bool (*Remove)(PriorityQueue* this, QueueHandle handle);
+};
+
+
 module(Collection) {
   embed(GenericList, List);
+  embed(GenericPriorityQueue, PriorityQueue);
 };
 
 
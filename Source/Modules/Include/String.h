@@ -41,11 +41,21 @@ module(String) {
 
   void (*Format)(string destination, const string formatStr, ...);
 
+  U32 (*FormatN)(string destination, U32 capacity, const string formatStr, ...);
+
+  U32 (*FormatV)(string destination, U32 capacity, const string formatStr, va_list argumentList);
+
   void (*Reverse)(string pointer);
 
   U32 (*GetLength)(string pointer);
 
   char* (*Search)(char* pointer, char ch, U32 count);
+
+  char* (*SearchAny)(char* pointer, const string set, U32 count);
+
+  I32 (*Compare)(const string a, const string b);
+
+  U32 (*CopyN)(string destination, const string source, U32 capacity);
   
 };
 
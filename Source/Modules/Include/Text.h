@@ -0,0 +1,109 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#ifndef __TEXT_H__
+#define __TEXT_H__
+
+#include "SystemCore.h"
+#include "Heap.h"
+
+
+// The amount of line breaks the line index can hold initially
+#define TEXT_INITIAL_LINE_CAPACITY 16
+
+
+// A gap buffer: the text is stored in one block with a movable hole
+// (the gap) at the cursor, so edits at the cursor never shift the rest.
+typedef struct TextBuffer {
+  HeapArea* Heap;
+
+  char* Data;
+  U32 Capacity;
+
+  // The gap spans [GapStart, GapEnd); GapStart is the cursor position
+  U32 GapStart;
+  U32 GapEnd;
+
+  // The positions of all line breaks in ascending order. The index has a
+  // gap of its own that follows the text gap: breaks in front of the
+  // cursor are stored as positions, breaks behind the cursor as their
+  // distance to the end of the text, so edits never touch other entries.
+  U32* Breaks;
+  U32 BreakCapacity;
+
+  // The index gap spans [BreakGapStart, BreakGapEnd)
+  U32 BreakGapStart;
+  U32 BreakGapEnd;
+} TextBuffer;
+
+
+
+module(Text) {
+  // Create a new text buffer with an initial capacity
+  TextBuffer* (*Create)(HeapArea* heap, U32 capacity);
+
+  // Free the buffer and its text
+  void (*Dispose)(TextBuffer* this);
+
+  // Insert text at the cursor (returns the amount of chars inserted)
+  U32 (*Insert)(TextBuffer* this, const char* text, U32 count);
+
+  // Delete chars before the cursor (returns the amount of chars deleted)
+  U32 (*DeleteBackward)(TextBuffer* this, U32 count);
+
+  // Delete chars after the cursor (returns the amount of chars deleted)
+  U32 (*DeleteForward)(TextBuffer* this, U32 count);
+
+  // Move the cursor relative to its position (returns the new position)
+  U32 (*MoveCursor)(TextBuffer* this, I32 offset);
+
+  // Place the cursor at an absolute position (returns the new position)
+  U32 (*SetCursor)(TextBuffer* this, U32 position);
+
+  // Return the amount of chars in the buffer
+  U32 (*GetLength)(TextBuffer* this);
+
+  // Return the char at a position (or 0 if out of range)
+  char (*GetChar)(TextBuffer* this, U32 position);
+
+  // Copy a range of text into a zero terminated string (returns the amount of chars copied)
+  U32 (*CopyRange)(TextBuffer* this, U32 start, U32 count, char* destination);
+
+  // Return the amount of lines in the buffer
+  U32 (*GetLineCount)(TextBuffer* this);
+
+  // Return the position at which a line starts
+  U32 (*GetLineStart)(TextBuffer* this, U32 line);
+
+  // Return the line that contains a position
+  U32 (*GetLineOf)(TextBuffer* this, U32 position);
+};
+
+
+#endif
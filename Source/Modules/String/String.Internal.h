@@ -0,0 +1,71 @@
+/*
+	
+  Copyright © 2025 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+
+#ifndef __STRING_INTERNAL_H__
+#define __STRING_INTERNAL_H__
+
+#include "../Include/String.h"
+
+
+// A machine word that may alias chars, so strings can be scanned four
+// chars at a time.
+typedef U32 __attribute__((may_alias)) StringWord;
+
+#define _STRING_WORD_SIZE sizeof(StringWord)
+
+#define _STRING_LOW_BITS 0x01010101
+
+#define _STRING_HIGH_BITS 0x80808080
+
+
+// Check whether any byte of a word is zero
+__attribute__((unused))
+static inline U32 _String_HasZero(U32 word) {
+  return (word - _STRING_LOW_BITS) & ~word & _STRING_HIGH_BITS;
+}
+
+// Fill every byte of a word with a char
+__attribute__((unused))
+static inline U32 _String_Broadcast(char ch) {
+  return (U8)ch * _STRING_LOW_BITS;
+}
+
+__attribute__((unused))
+static inline bool _String_IsAligned(const void* pointer) {
+  return !((U32)pointer & (_STRING_WORD_SIZE - 1));
+}
+
+// Check whether two pointers can be word aligned at the same time
+__attribute__((unused))
+static inline bool _String_HaveSameAlignment(const void* a, const void* b) {
+  return !(((U32)a ^ (U32)b) & (_STRING_WORD_SIZE - 1));
+}
+
+
+#endif
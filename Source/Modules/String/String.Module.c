@@ -31,14 +31,24 @@
 
 
 void	_String_FormatImplementation(string destination, const string formatStr, ...);
+U32	_String_FormatNImplementation(string destination, U32 capacity, const string formatStr, ...);
+U32	_String_FormatVImplementation(string destination, U32 capacity, const string formatStr, va_list argumentList);
 void	_String_ReverseImplementation(string pointer);
 U32	_String_GetLengthImplementation(string pointer);
 char* _String_SearchImplementation(char* pointer, char ch, U32 count);
+char* _String_SearchAnyImplementation(char* pointer, const string set, U32 count);
+I32	_String_CompareImplementation(const string a, const string b);
+U32	_String_CopyNImplementation(string destination, const string source, U32 capacity);
 
 members(String) {
   
     .Format    = _String_FormatImplementation,
+    .FormatN   = _String_FormatNImplementation,
+    .FormatV   = _String_FormatVImplementation,
     .Reverse   = _String_ReverseImplementation,
     .GetLength = _String_GetLengthImplementation,
-    .Search    = _String_SearchImplementation
+    .Search    = _String_SearchImplementation,
+    .SearchAny = _String_SearchAnyImplementation,
+    .Compare   = _String_CompareImplementation,
+    .CopyN     = _String_CopyNImplementation
 };
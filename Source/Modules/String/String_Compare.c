@@ -0,0 +1,59 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "String.Internal.h"
+
+
+I32 _String_CompareImplementation(const string a, const string b) {
+  const U8* aPtr = (const U8*)a;
+  const U8* bPtr = (const U8*)b;
+
+  // Compare word by word, if both strings can be aligned at once
+  if (_String_HaveSameAlignment(aPtr, bPtr)) {
+    for (; !_String_IsAligned(aPtr); aPtr++, bPtr++)
+      if (*aPtr != *bPtr || !*aPtr)
+	return *aPtr - *bPtr;
+
+    const StringWord* aWord = (const StringWord*)aPtr;
+    const StringWord* bWord = (const StringWord*)bPtr;
+
+    while (*aWord == *bWord && !_String_HasZero(*aWord)) {
+      aWord++;
+      bWord++;
+    }
+
+    aPtr = (const U8*)aWord;
+    bPtr = (const U8*)bWord;
+  }
+
+  for (; *aPtr == *bPtr && *aPtr; aPtr++, bPtr++)
+    ;
+
+  return *aPtr - *bPtr;
+}
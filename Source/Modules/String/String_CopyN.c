@@ -0,0 +1,66 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "String.Internal.h"
+
+
+U32 _String_CopyNImplementation(string destination, const string source, U32 capacity) {
+  if (!capacity)
+    return 0;
+
+  char* destPtr = destination;
+  const char* srcPtr = source;
+
+  // Reserve space for the terminator
+  U32 remaining = capacity - 1;
+
+  // Copy word by word, if both strings can be aligned at once
+  if (_String_HaveSameAlignment(destPtr, srcPtr)) {
+    for (; remaining && !_String_IsAligned(srcPtr) && *srcPtr; remaining--)
+      *destPtr++ = *srcPtr++;
+
+    if (_String_IsAligned(srcPtr)) {
+      StringWord* destWord = (StringWord*)destPtr;
+      const StringWord* srcWord = (const StringWord*)srcPtr;
+
+      for (; remaining >= _STRING_WORD_SIZE && !_String_HasZero(*srcWord); remaining -= _STRING_WORD_SIZE)
+	*destWord++ = *srcWord++;
+
+      destPtr = (char*)destWord;
+      srcPtr = (const char*)srcWord;
+    }
+  }
+
+  for (; remaining && *srcPtr; remaining--)
+    *destPtr++ = *srcPtr++;
+
+  *destPtr = '\0';
+
+  return destPtr - destination;
+}
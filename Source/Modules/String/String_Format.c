@@ -33,114 +33,12 @@
 use(String);
 
 
-static const string Alphabet = "0123456789abcdef";
-
-
-static void _StringFormat_WriteHexInt(U32 value, string destination, U8 length);
-static string _Format_AsDecimal(U32 value, string buffer);
-static string _Format_AsChar(char c, string buffer);
-
-
-
-
 void _String_FormatImplementation(string destination, const string formatStr, ...) {
   va_list argumentList;
   va_start(argumentList, formatStr);
 
-  for (char *formatPtr = formatStr; *formatPtr; formatPtr++) {
-    if (*formatPtr != '%') {
-      *destination++ = *formatPtr;
-      continue;
-    }
-
-    char formatType = *(formatPtr + 1);
-    switch (formatType) {
-    case 'x':
-      formatPtr++;
-      *destination++ = '0';
-      *destination++ = 'x';
-
-      switch (*formatPtr) {
-      case 'b':
-	_StringFormat_WriteHexInt(va_arg(argumentList, int), destination, 2);
-	destination += 2;
-	formatPtr++;
-	break;
-
-      case 'd':
-	_StringFormat_WriteHexInt(va_arg(argumentList, int), destination, 4);
-	destination += 4;
-	formatPtr++;
-	break;
-
-      case 'l':
-	_StringFormat_WriteHexInt(va_arg(argumentList, int), destination, 16);
-	destination += 16;
-	formatPtr++;
-	break;
-
-      default:
-	_StringFormat_WriteHexInt(va_arg(argumentList, int), destination, 8);
-	destination += 8;
-	break;
-      }
-      
-      break;
-
-
-    case 'd':
-	formatPtr++;
-	destination = _Format_AsDecimal(va_arg(argumentList, int), destination);
-        break;
-
-	
-    case 'c':
-      formatPtr++;
-      destination = _Format_AsChar(va_arg(argumentList, int), destination);
-      break;
-    }
+  // The size of the destination is unknown
+  String.FormatV(destination, 0xffffffff, formatStr, argumentList);
 
-    
-  }
-  
-  *destination++ = '\0';
   va_end(argumentList);
 }
-
-
-
-static void _StringFormat_WriteHexInt(U32 value, string destination, U8 length) {
-  destination[length] = '\0';
-
-  while (length--) {
-    destination[length] = Alphabet[value & 0xf];
-    value >>= 4;
-  }
-}
-
-static string _Format_AsChar(char c, string buffer) {
-  if (c < 0x20 || c > 0x7f)
-    *buffer++ = '0';
-  else
-    *buffer++ = (char)c;
-
-  return buffer;
-}
-
-
-static string _Format_AsDecimal(U32 value, string buffer) {
-  char temp[32] = { };
-  string tempPtr = temp;
-  
-  do {
-    *tempPtr++ = (value % 10) + *Alphabet;
-    value /= 10;
-  } while(value);
-
-  String.Reverse(temp);
-
-  for (char* tempChar = temp; *tempChar; tempChar++)
-    *buffer++ = *tempChar;
-  
-  return buffer;
-}
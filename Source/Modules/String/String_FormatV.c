@@ -0,0 +1,288 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "../Include/String.h"
+
+
+static const string Alphabet = "0123456789abcdef";
+
+// All numbers from 00 to 99, so that two digits are converted per division
+static const char _DecimalPairs[200] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+
+// The longest number is a 16 digit hex value with prefix
+#define _FORMAT_NUMBER_SIZE 18
+
+// The longest decimal is a sign with ten digits
+#define _FORMAT_DECIMAL_SIZE 11
+
+// Wider fields are clipped to the width the spec can hold
+#define _FORMAT_MAX_WIDTH 0xff
+
+
+typedef struct FormatSpec {
+  U8 Width;
+  bool ZeroPad;
+  bool LeftAlign;
+} FormatSpec;
+
+
+static inline string _PutPadded(string output, string end, const char* text, U32 length, FormatSpec spec);
+static inline U32 _Format_AsDecimal(U32 value, char* bufferEnd);
+static inline U32 _Format_CountDecimalDigits(U32 value);
+static U32 _Format_AsHex(U32 value, U8 digits, char* bufferEnd);
+static char _Format_AsChar(char c);
+
+
+
+U32 _String_FormatVImplementation(string destination, U32 capacity, const string formatStr, va_list argumentList) {
+  if (!destination || !capacity)
+    return 0;
+
+  string output = destination;
+  // The last writable char (reserved for the terminator)
+  string end = destination + capacity - 1;
+
+  // Prevent the end pointer from wrapping around for unbounded calls
+  if (end < destination)
+    end = (string)0xffffffff;
+
+  char number[_FORMAT_NUMBER_SIZE];
+  char* numberEnd = number + sizeof(number);
+
+  for (const char *formatPtr = formatStr; *formatPtr; formatPtr++) {
+    if (*formatPtr != '%') {
+      if (output < end)
+	*output++ = *formatPtr;
+      continue;
+    }
+
+    FormatSpec spec = { };
+    formatPtr++;
+
+    // Flags
+    for (;; formatPtr++) {
+      if (*formatPtr == '0')
+	spec.ZeroPad = true;
+      else if (*formatPtr == '-')
+	spec.LeftAlign = true;
+      else
+	break;
+    }
+
+    // Width
+    for (U32 width = 0; *formatPtr >= '0' && *formatPtr <= '9'; formatPtr++) {
+      width = width * 10 + (*formatPtr - '0');
+      if (width > _FORMAT_MAX_WIDTH)
+	width = _FORMAT_MAX_WIDTH;
+      spec.Width = width;
+    }
+
+    U32 length;
+    switch (*formatPtr) {
+    case 'x': {
+      U8 digits = 8;
+      switch (formatPtr[1]) {
+      case 'b': digits = 2; formatPtr++; break;
+      case 'd': digits = 4; formatPtr++; break;
+      case 'l': digits = 16; formatPtr++; break;
+      }
+
+      length = _Format_AsHex(va_arg(argumentList, U32), digits, numberEnd);
+      output = _PutPadded(output, end, numberEnd - length, length, spec);
+      break;
+    }
+
+    case 'd':
+    case 'i':
+    case 'u': {
+      U32 magnitude = va_arg(argumentList, U32);
+      bool negative = *formatPtr != 'u' && (I32)magnitude < 0;
+      if (negative)
+	magnitude = -magnitude;
+
+      // Without a field width the digits go straight into the output
+      if (!spec.Width && (U32)(end - output) >= _FORMAT_DECIMAL_SIZE) {
+	if (negative)
+	  *output++ = '-';
+
+	output += _Format_CountDecimalDigits(magnitude);
+	_Format_AsDecimal(magnitude, output);
+	break;
+      }
+
+      length = _Format_AsDecimal(magnitude, numberEnd);
+      if (negative) {
+	// Zero padding goes between sign and digits
+	if (spec.ZeroPad && !spec.LeftAlign) {
+	  if (output < end)
+	    *output++ = '-';
+	  if (spec.Width)
+	    spec.Width--;
+	} else {
+	  number[sizeof(number) - ++length] = '-';
+	}
+      }
+
+      output = _PutPadded(output, end, numberEnd - length, length, spec);
+      break;
+    }
+
+    case 'c':
+      number[0] = _Format_AsChar(va_arg(argumentList, int));
+      spec.ZeroPad = false;
+      output = _PutPadded(output, end, number, 1, spec);
+      break;
+
+    case 's': {
+      const char* text = va_arg(argumentList, const char*);
+      if (!text)
+	text = "(null)";
+
+      for (length = 0; text[length]; length++);
+      spec.ZeroPad = false;
+      output = _PutPadded(output, end, text, length, spec);
+      break;
+    }
+
+    case '%':
+      if (output < end)
+	*output++ = '%';
+      break;
+
+    case '\0':
+      // Dangling percent sign at the end of the format string
+      formatPtr--;
+      break;
+
+    default:
+      if (output < end)
+	*output++ = *formatPtr;
+      break;
+    }
+  }
+
+  *output = '\0';
+
+  return output - destination;
+}
+
+
+
+static inline string _PutPadded(string output, string end, const char* text, U32 length, FormatSpec spec) {
+  U32 padding = spec.Width > length ? spec.Width - length : 0;
+  char padChar = spec.ZeroPad ? '0' : ' ';
+
+  // Clip the output once instead of checking every char
+  U32 available = end - output;
+
+  if (!spec.LeftAlign)
+    for (; padding && available; padding--, available--)
+      *output++ = padChar;
+
+  for (; length && available; length--, available--)
+    *output++ = *text++;
+
+  for (; padding && available; padding--, available--)
+    *output++ = ' ';
+
+  return output;
+}
+
+
+// Write the digits right aligned in front of bufferEnd (returns the amount of digits)
+static inline U32 _Format_AsDecimal(U32 value, char* bufferEnd) {
+  char* digit = bufferEnd;
+
+  while (value >= 100) {
+    U32 pair = (value % 100) << 1;
+    value /= 100;
+
+    *--digit = _DecimalPairs[pair + 1];
+    *--digit = _DecimalPairs[pair];
+  }
+
+  if (value >= 10) {
+    *--digit = _DecimalPairs[(value << 1) + 1];
+    *--digit = _DecimalPairs[value << 1];
+  } else {
+    *--digit = Alphabet[value];
+  }
+
+  return bufferEnd - digit;
+}
+
+
+// Compare against the powers of ten instead of dividing
+static inline U32 _Format_CountDecimalDigits(U32 value) {
+  if (value < 100000) {
+    if (value < 100)
+      return value < 10 ? 1 : 2;
+
+    return value < 1000 ? 3 : value < 10000 ? 4 : 5;
+  }
+
+  if (value < 10000000)
+    return value < 1000000 ? 6 : 7;
+
+  return value < 100000000 ? 8 : value < 1000000000 ? 9 : 10;
+}
+
+
+static U32 _Format_AsHex(U32 value, U8 digits, char* bufferEnd) {
+  char* digit = bufferEnd;
+
+  for (U8 index = 0; index < digits; index++) {
+    *--digit = Alphabet[value & 0xf];
+    value >>= 4;
+  }
+
+  *--digit = 'x';
+  *--digit = '0';
+
+  return bufferEnd - digit;
+}
+
+
+static char _Format_AsChar(char c) {
+  if (c < 0x20 || (U8)c > 0x7f)
+    return '0';
+
+  return c;
+}
@@ -27,12 +27,23 @@
 */
 
 
-#include "../Include/String.h"
+#include "String.Internal.h"
 
 
 U32 _String_GetLengthImplementation(string pointer) {
-  string posPtr = pointer;
-  for (;*posPtr; posPtr++)
+  const char* posPtr = pointer;
+
+  // Check the chars in front of the first aligned word
+  for (; !_String_IsAligned(posPtr); posPtr++)
+    if (!*posPtr)
+      return posPtr - pointer;
+
+  // Aligned words never cross a page, so reading past the end is safe
+  const StringWord* wordPtr = (const StringWord*)posPtr;
+  while (!_String_HasZero(*wordPtr))
+    wordPtr++;
+
+  for (posPtr = (const char*)wordPtr; *posPtr; posPtr++)
     ;
 
   return posPtr - pointer;  
@@ -27,11 +27,29 @@
 */
 
 
-#include "../Include/String.h"
+#include "String.Internal.h"
 
 
 char* _String_SearchImplementation(char* pointer, char ch, U32 count) {
-  for (char* ptr = pointer; *ptr && count--; ptr++) {
+  char* ptr = pointer;
+
+  // Check the chars in front of the first aligned word
+  for (; count && !_String_IsAligned(ptr); ptr++, count--) {
+    if (!*ptr)
+      return null;
+    if (*ptr == ch)
+      return ptr;
+  }
+
+  // Skip all words without the terminator or the char
+  U32 pattern = _String_Broadcast(ch);
+  const StringWord* wordPtr = (const StringWord*)ptr;
+
+  for (; count >= _STRING_WORD_SIZE; wordPtr++, count -= _STRING_WORD_SIZE)
+    if (_String_HasZero(*wordPtr) || _String_HasZero(*wordPtr ^ pattern))
+      break;
+
+  for (ptr = (char*)wordPtr; *ptr && count--; ptr++) {
     if (*ptr == ch)
       return ptr;
   }
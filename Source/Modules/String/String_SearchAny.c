@@ -0,0 +1,48 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "../Include/String.h"
+
+
+char* _String_SearchAnyImplementation(char* pointer, const string set, U32 count) {
+  if (!set)
+    return null;
+
+  // One bit per char, so every char is checked with a single lookup
+  U32 charMap[256 / 32] = { };
+  for (const U8* setPtr = (const U8*)set; *setPtr; setPtr++)
+    charMap[*setPtr >> 5] |= 1u << (*setPtr & 31);
+
+  for (U8* ptr = (U8*)pointer; *ptr && count--; ptr++) {
+    if (charMap[*ptr >> 5] & (1u << (*ptr & 31)))
+      return (char*)ptr;
+  }
+
+  return null;
+}
@@ -0,0 +1,62 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "../Include/Text.h"
+
+
+extern TextBuffer*	_Text_CreateImplementation(HeapArea* heap, U32 capacity);
+extern void		_Text_DisposeImplementation(TextBuffer* this);
+extern U32		_Text_InsertImplementation(TextBuffer* this, const char* text, U32 count);
+extern U32		_Text_DeleteBackwardImplementation(TextBuffer* this, U32 count);
+extern U32		_Text_DeleteForwardImplementation(TextBuffer* this, U32 count);
+extern U32		_Text_MoveCursorImplementation(TextBuffer* this, I32 offset);
+extern U32		_Text_SetCursorImplementation(TextBuffer* this, U32 position);
+extern U32		_Text_GetLengthImplementation(TextBuffer* this);
+extern char		_Text_GetCharImplementation(TextBuffer* this, U32 position);
+extern U32		_Text_CopyRangeImplementation(TextBuffer* this, U32 start, U32 count, char* destination);
+extern U32		_Text_GetLineCountImplementation(TextBuffer* this);
+extern U32		_Text_GetLineStartImplementation(TextBuffer* this, U32 line);
+extern U32		_Text_GetLineOfImplementation(TextBuffer* this, U32 position);
+
+
+members(Text) {
+    .Create         = _Text_CreateImplementation,
+    .Dispose        = _Text_DisposeImplementation,
+    .Insert         = _Text_InsertImplementation,
+    .DeleteBackward = _Text_DeleteBackwardImplementation,
+    .DeleteForward  = _Text_DeleteForwardImplementation,
+    .MoveCursor     = _Text_MoveCursorImplementation,
+    .SetCursor      = _Text_SetCursorImplementation,
+    .GetLength      = _Text_GetLengthImplementation,
+    .GetChar        = _Text_GetCharImplementation,
+    .CopyRange      = _Text_CopyRangeImplementation,
+    .GetLineCount   = _Text_GetLineCountImplementation,
+    .GetLineStart   = _Text_GetLineStartImplementation,
+    .GetLineOf      = _Text_GetLineOfImplementation
+};
@@ -0,0 +1,60 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "../Include/Text.h"
+
+extern U32 _TextBuffer_GetLength(TextBuffer* this);
+extern U32 _TextBuffer_GetIndex(TextBuffer* this, U32 position);
+
+
+U32 _Text_CopyRangeImplementation(TextBuffer* this, U32 start, U32 count, char* destination) {
+  if (!this || !destination)
+    return 0;
+
+  U32 length = _TextBuffer_GetLength(this);
+  if (start > length)
+    start = length;
+  if (count > length - start)
+    count = length - start;
+
+  U32 copied = 0;
+
+  // Copy the part in front of the gap
+  for (U32 position = start; position < this->GapStart && copied < count; position++)
+    destination[copied++] = this->Data[position];
+
+  // Copy the part behind the gap
+  const char* tail = this->Data + _TextBuffer_GetIndex(this, start + copied);
+  while (copied < count)
+    destination[copied++] = *tail++;
+
+  destination[copied] = 0;
+
+  return copied;
+}
@@ -0,0 +1,67 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "../Include/Text.h"
+
+use(Heap);
+
+
+TextBuffer* _Text_CreateImplementation(HeapArea* heap, U32 capacity) {
+  TextBuffer* buffer;
+
+  if (!heap || !capacity || !(buffer = Heap.Allocate(heap, sizeof(TextBuffer))))
+    return null;
+
+  char* data = Heap.Allocate(heap, capacity);
+  if (!data) {
+    Heap.Free(heap, buffer);
+    return null;
+  }
+
+  U32* breaks = Heap.Allocate(heap, TEXT_INITIAL_LINE_CAPACITY * sizeof(U32));
+  if (!breaks) {
+    Heap.Free(heap, data);
+    Heap.Free(heap, buffer);
+    return null;
+  }
+
+  *buffer = (TextBuffer) {
+    .Heap = heap,
+    .Data = data,
+    .Capacity = capacity,
+    .GapStart = 0,
+    .GapEnd = capacity,
+    .Breaks = breaks,
+    .BreakCapacity = TEXT_INITIAL_LINE_CAPACITY,
+    .BreakGapStart = 0,
+    .BreakGapEnd = TEXT_INITIAL_LINE_CAPACITY
+  };
+
+  return buffer;
+}
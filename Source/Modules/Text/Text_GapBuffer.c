@@ -0,0 +1,115 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "../Include/Text.h"
+
+
+// Gap buffer helpers shared by the text functions
+
+
+U32 _TextBuffer_GetGapSize(TextBuffer* this) {
+  return this->GapEnd - this->GapStart;
+}
+
+
+U32 _TextBuffer_GetLength(TextBuffer* this) {
+  return this->Capacity - _TextBuffer_GetGapSize(this);
+}
+
+
+// Translate a text position into an index of the data block
+U32 _TextBuffer_GetIndex(TextBuffer* this, U32 position) {
+  return position < this->GapStart
+    ? position
+    : position + _TextBuffer_GetGapSize(this);
+}
+
+
+U32 _TextBuffer_GetBreakCount(TextBuffer* this) {
+  return this->BreakCapacity - (this->BreakGapEnd - this->BreakGapStart);
+}
+
+
+// Return the position of a line break by its index
+U32 _TextBuffer_GetBreak(TextBuffer* this, U32 index) {
+  if (index < this->BreakGapStart)
+    return this->Breaks[index];
+
+  U32 distance = this->Breaks[index + this->BreakGapEnd - this->BreakGapStart];
+
+  return _TextBuffer_GetLength(this) - distance;
+}
+
+
+// Return the amount of line breaks in front of a position
+U32 _TextBuffer_CountBreaksBefore(TextBuffer* this, U32 position) {
+  U32 low = 0;
+  U32 high = _TextBuffer_GetBreakCount(this);
+
+  while (low < high) {
+    U32 middle = (low + high) >> 1;
+
+    if (_TextBuffer_GetBreak(this, middle) < position)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+
+  return low;
+}
+
+
+// Move the gap, so that it starts at a certain text position
+void _TextBuffer_MoveGap(TextBuffer* this, U32 position) {
+  char* data = this->Data;
+  U32 length = _TextBuffer_GetLength(this);
+
+  while (this->GapStart > position) {
+    char ch = data[--this->GapStart];
+    data[--this->GapEnd] = ch;
+
+    // The break moves behind the cursor
+    if (ch == '\n') {
+      U32 breakPosition = this->Breaks[--this->BreakGapStart];
+      this->Breaks[--this->BreakGapEnd] = length - breakPosition;
+    }
+  }
+
+  while (this->GapStart < position) {
+    char ch = data[this->GapEnd++];
+
+    // The break moves in front of the cursor
+    if (ch == '\n') {
+      U32 breakDistance = this->Breaks[this->BreakGapEnd++];
+      this->Breaks[this->BreakGapStart++] = length - breakDistance;
+    }
+
+    data[this->GapStart++] = ch;
+  }
+}
@@ -0,0 +1,114 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "../Include/Text.h"
+
+extern U32 _TextBuffer_GetGapSize(TextBuffer* this);
+extern U32 _TextBuffer_GetLength(TextBuffer* this);
+
+use(Heap);
+
+static bool _TryGrowText(TextBuffer* this, U32 minGapSize);
+static bool _TryGrowLineIndex(TextBuffer* this);
+
+
+U32 _Text_InsertImplementation(TextBuffer* this, const char* text, U32 count) {
+  if (!this || !text)
+    return 0;
+
+  // Insert as much as possible if the heap is exhausted
+  if (_TextBuffer_GetGapSize(this) < count && !_TryGrowText(this, count))
+    count = _TextBuffer_GetGapSize(this);
+
+  for (U32 index = 0; index < count; index++) {
+    if (text[index] == '\n') {
+      if (this->BreakGapStart == this->BreakGapEnd && !_TryGrowLineIndex(this))
+	return index;
+
+      this->Breaks[this->BreakGapStart++] = this->GapStart;
+    }
+
+    this->Data[this->GapStart++] = text[index];
+  }
+
+  return count;
+}
+
+
+static bool _TryGrowText(TextBuffer* this, U32 minGapSize) {
+  U32 length = _TextBuffer_GetLength(this);
+
+  // Double the capacity, so that inserts stay amortized constant time
+  U32 capacity = this->Capacity << 1;
+  if (capacity < length + minGapSize)
+    capacity = length + minGapSize;
+
+  char* data = Heap.Allocate(this->Heap, capacity);
+  if (!data)
+    return false;
+
+  U32 tailSize = this->Capacity - this->GapEnd;
+  U32 gapEnd = capacity - tailSize;
+
+  for (U32 index = 0; index < this->GapStart; index++)
+    data[index] = this->Data[index];
+  for (U32 index = 0; index < tailSize; index++)
+    data[gapEnd + index] = this->Data[this->GapEnd + index];
+
+  Heap.Free(this->Heap, this->Data);
+  this->Data = data;
+  this->Capacity = capacity;
+  this->GapEnd = gapEnd;
+
+  return true;
+}
+
+
+static bool _TryGrowLineIndex(TextBuffer* this) {
+  U32 capacity = this->BreakCapacity << 1;
+
+  U32* breaks = Heap.Allocate(this->Heap, capacity * sizeof(U32));
+  if (!breaks)
+    return false;
+
+  U32 tailSize = this->BreakCapacity - this->BreakGapEnd;
+  U32 gapEnd = capacity - tailSize;
+
+  for (U32 index = 0; index < this->BreakGapStart; index++)
+    breaks[index] = this->Breaks[index];
+  for (U32 index = 0; index < tailSize; index++)
+    breaks[gapEnd + index] = this->Breaks[this->BreakGapEnd + index];
+
+  Heap.Free(this->Heap, this->Breaks);
+  this->Breaks = breaks;
+  this->BreakCapacity = capacity;
+  this->BreakGapEnd = gapEnd;
+
+  return true;
+}
@@ -0,0 +1,59 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+#include <stdio.h>
+#include <time.h>
+
+
+// Get a monotonic timestamp in nanoseconds
+static inline double Benchmark_Now(void) {
+  struct timespec timestamp;
+  clock_gettime(CLOCK_MONOTONIC, &timestamp);
+
+  return (double)timestamp.tv_sec * 1e9 + (double)timestamp.tv_nsec;
+}
+
+
+// Execute a statement a number of times and report the average duration
+// of a single execution.
+#define BENCHMARK(name, iterations, statement)				\
+  do {									\
+    double __benchmarkStart = Benchmark_Now();				\
+    for (unsigned __benchmarkIndex = 0; __benchmarkIndex < (iterations); __benchmarkIndex++) { \
+      statement;							\
+    }									\
+    double __benchmarkTotal = Benchmark_Now() - __benchmarkStart;	\
+    printf("%-56s %12.1f ns\n", (name), __benchmarkTotal / (iterations)); \
+  } while (0)
+
+
+#endif
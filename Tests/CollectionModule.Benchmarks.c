@@ -0,0 +1,119 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "Benchmark.h"
+
+#include "../Source/Modules/Include/Collection.h"
+
+
+use(Collection);
+use(Heap);
+
+
+#define QUEUE_SIZE 1024
+
+static U8 _HeapBuffer[64 * 1024];
+static U32 _Keys[QUEUE_SIZE];
+static QueueHandle _Handles[QUEUE_SIZE];
+
+
+static void _InitializeKeys(void) {
+  U32 seed = 12345;
+
+  for (U32 index = 0; index < QUEUE_SIZE; index++) {
+    seed = seed * 1103515245 + 12345;
+    _Keys[index] = (seed >> 8) & 0xffff;
+  }
+}
+
+
+static void _PushAll(PriorityQueue* queue) {
+  for (U32 index = 0; index < QUEUE_SIZE; index++)
+    _Handles[index] = Collection.PriorityQueue.Push(queue, _Keys[index], &_Keys[index]);
+}
+
+
+static void _PopAll(PriorityQueue* queue) {
+  while (queue->Count)
+    Collection.PriorityQueue.PopMin(queue, null);
+}
+
+
+static void _DecreaseAll(PriorityQueue* queue) {
+  for (U32 index = 0; index < QUEUE_SIZE; index++)
+    Collection.PriorityQueue.DecreaseKey(queue, _Handles[index], _Keys[index] / 2);
+}
+
+
+static void _RemoveAll(PriorityQueue* queue) {
+  for (U32 index = 0; index < QUEUE_SIZE; index++)
+    Collection.PriorityQueue.Remove(queue, _Handles[index]);
+}
+
+
+// Reference: an unordered array scanned for its minimum on every pop
+static U32 _Unordered[QUEUE_SIZE];
+
+static void _ScanPopAll(void) {
+  for (U32 count = QUEUE_SIZE; count; count--) {
+    U32 minimumIndex = 0;
+
+    for (U32 index = 1; index < count; index++)
+      if (_Unordered[index] < _Unordered[minimumIndex])
+	minimumIndex = index;
+
+    _Unordered[minimumIndex] = _Unordered[count - 1];
+  }
+}
+
+
+int main(void) {
+  _InitializeKeys();
+
+  HeapArea* heap = Heap.Initialize(_HeapBuffer, sizeof(_HeapBuffer));
+  PriorityQueue* queue = Collection.PriorityQueue.Create(heap, QUEUE_SIZE);
+  if (!queue)
+    return 1;
+
+  printf("PriorityQueue (%d entries, time per batch)\n", QUEUE_SIZE);
+
+  BENCHMARK("Push + PopMin", 200, _PushAll(queue); _PopAll(queue));
+  BENCHMARK("Push + DecreaseKey + PopMin", 200, _PushAll(queue); _DecreaseAll(queue); _PopAll(queue));
+  BENCHMARK("Push + Remove", 200, _PushAll(queue); _RemoveAll(queue));
+
+  Collection.PriorityQueue.Dispose(queue);
+
+
+  BENCHMARK("Reference: unordered array + linear scan", 20,
+	    for (U32 index = 0; index < QUEUE_SIZE; index++)
+	      _Unordered[index] = _Keys[index];
+	    _ScanPopAll());
+
+  return 0;
+}
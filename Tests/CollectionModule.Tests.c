@@ -607,9 +607,285 @@ MU_TEST_SUITE(GenericList) {
 
 
 
+// Priority queue tests
+
+MU_TEST(GenericPriorityQueue_Create__HeapIsNull__ReturnsNull) {
+  mu_assert(!Collection.PriorityQueue.Create(null, 8), "Create returned not null.");
+}
+
+MU_TEST(GenericPriorityQueue_Create__CapacityIsZero__ReturnsNull) {
+  U8 testBuffer[512];
+
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  mu_assert(heap, "Unable to initialize heap.");
+
+  mu_assert(!Collection.PriorityQueue.Create(heap, 0), "Create returned not null.");
+}
+
+MU_TEST(GenericPriorityQueue_Create__SizeOverflows__ReturnsNull) {
+  U8 testBuffer[512];
+
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  mu_assert(heap, "Unable to initialize heap.");
+
+  // The entries and the order take 2^32 bytes, which wraps to zero
+  mu_assert(!Collection.PriorityQueue.Create(heap, 0x10000000), "Create returned not null.");
+}
+
+MU_TEST(GenericPriorityQueue_Create__EnoughSpace__CreatesInstance) {
+  U8 testBuffer[512];
+
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  mu_assert(heap, "Unable to initialize heap.");
+
+  PriorityQueue* queue = Collection.PriorityQueue.Create(heap, 8);
+
+  mu_assert(queue, "Unable to create queue.");
+  mu_assert(queue->Heap == heap, "Heap pointer was not set.");
+  mu_assert_int_eq(8, queue->Capacity);
+  mu_assert_int_eq(0, queue->Count);
+}
+
+MU_TEST(GenericPriorityQueue_Dispose__Always__FreesAll) {
+  U8 testBuffer[512];
+
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  mu_assert(heap, "Unable to initialize heap.");
+  U32 bytesFreeBefore = heap->TotalBytesFree;
+
+  PriorityQueue* queue = Collection.PriorityQueue.Create(heap, 8);
+  mu_assert(queue, "Unable to create queue.");
+
+  Collection.PriorityQueue.Dispose(queue);
+
+  mu_assert_int_eq(bytesFreeBefore, heap->TotalBytesFree);
+}
+
+
+MU_TEST(GenericPriorityQueue_Push__QueueIsFull__ReturnsInvalidHandle) {
+  U8 testBuffer[512];
+
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  mu_assert(heap, "Unable to initialize heap.");
+  PriorityQueue* queue = Collection.PriorityQueue.Create(heap, 2);
+  mu_assert(queue, "Unable to create queue.");
+
+  mu_check(Collection.PriorityQueue.Push(queue, 1, null) != QUEUE_INVALID_HANDLE);
+  mu_check(Collection.PriorityQueue.Push(queue, 2, null) != QUEUE_INVALID_HANDLE);
+  mu_check(Collection.PriorityQueue.Push(queue, 3, null) == QUEUE_INVALID_HANDLE);
+  mu_assert_int_eq(2, queue->Count);
+}
+
+
+MU_TEST(GenericPriorityQueue_PopMin__QueueIsEmpty__ReturnsNull) {
+  U8 testBuffer[512];
+
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  mu_assert(heap, "Unable to initialize heap.");
+  PriorityQueue* queue = Collection.PriorityQueue.Create(heap, 4);
+  mu_assert(queue, "Unable to create queue.");
+
+  mu_check(!Collection.PriorityQueue.PopMin(queue, null));
+}
+
+MU_TEST(GenericPriorityQueue_PopMin__NotEmpty__ReturnsEntriesInKeyOrder) {
+  U8 testBuffer[1024];
+
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  mu_assert(heap, "Unable to initialize heap.");
+  PriorityQueue* queue = Collection.PriorityQueue.Create(heap, 16);
+  mu_assert(queue, "Unable to create queue.");
+
+  U32 keys[] = { 42, 7, 19, 3, 88, 7, 25, 1, 64, 13 };
+  U32 keyCount = sizeof(keys) / sizeof(keys[0]);
+  for (U32 index = 0; index < keyCount; index++)
+    Collection.PriorityQueue.Push(queue, keys[index], &keys[index]);
+  mu_assert_int_eq(keyCount, queue->Count);
+
+  U32 previousKey = 0;
+  for (U32 index = 0; index < keyCount; index++) {
+    U32 key;
+    U32* payload = Collection.PriorityQueue.PopMin(queue, &key);
+
+    mu_assert(payload, "No payload returned.");
+    mu_assert_int_eq(*payload, key);
+    mu_check(previousKey <= key);
+    previousKey = key;
+  }
+
+  mu_assert_int_eq(0, queue->Count);
+}
+
+
+MU_TEST(GenericPriorityQueue_PeekMin__NotEmpty__KeepsEntry) {
+  U8 testBuffer[512];
+
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  mu_assert(heap, "Unable to initialize heap.");
+  PriorityQueue* queue = Collection.PriorityQueue.Create(heap, 4);
+  mu_assert(queue, "Unable to create queue.");
+
+  U8 first, second;
+  Collection.PriorityQueue.Push(queue, 20, &second);
+  Collection.PriorityQueue.Push(queue, 10, &first);
+
+  U32 key;
+  mu_check(Collection.PriorityQueue.PeekMin(queue, &key) == &first);
+  mu_assert_int_eq(10, key);
+  mu_assert_int_eq(2, queue->Count);
+}
+
+
+MU_TEST(GenericPriorityQueue_DecreaseKey__LowerKey__MovesEntryToFront) {
+  U8 testBuffer[512];
+
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  mu_assert(heap, "Unable to initialize heap.");
+  PriorityQueue* queue = Collection.PriorityQueue.Create(heap, 4);
+  mu_assert(queue, "Unable to create queue.");
+
+  U8 first, second, third;
+  Collection.PriorityQueue.Push(queue, 10, &first);
+  Collection.PriorityQueue.Push(queue, 20, &second);
+  QueueHandle handle = Collection.PriorityQueue.Push(queue, 30, &third);
+
+  mu_check(Collection.PriorityQueue.DecreaseKey(queue, handle, 5));
+  mu_check(Collection.PriorityQueue.PopMin(queue, null) == &third);
+  mu_check(Collection.PriorityQueue.PopMin(queue, null) == &first);
+}
+
+MU_TEST(GenericPriorityQueue_DecreaseKey__HigherKey__ReturnsFalse) {
+  U8 testBuffer[512];
+
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  mu_assert(heap, "Unable to initialize heap.");
+  PriorityQueue* queue = Collection.PriorityQueue.Create(heap, 4);
+  mu_assert(queue, "Unable to create queue.");
+
+  QueueHandle handle = Collection.PriorityQueue.Push(queue, 10, null);
+
+  mu_check(!Collection.PriorityQueue.DecreaseKey(queue, handle, 11));
+  mu_check(!Collection.PriorityQueue.DecreaseKey(queue, QUEUE_INVALID_HANDLE, 1));
+}
+
+
+MU_TEST(GenericPriorityQueue_Remove__Queued__RemovesEntry) {
+  U8 testBuffer[1024];
+
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  mu_assert(heap, "Unable to initialize heap.");
+  PriorityQueue* queue = Collection.PriorityQueue.Create(heap, 8);
+  mu_assert(queue, "Unable to create queue.");
+
+  U8 a, b, c, d;
+  Collection.PriorityQueue.Push(queue, 40, &d);
+  QueueHandle handle = Collection.PriorityQueue.Push(queue, 10, &a);
+  Collection.PriorityQueue.Push(queue, 30, &c);
+  Collection.PriorityQueue.Push(queue, 20, &b);
+
+  mu_check(Collection.PriorityQueue.Remove(queue, handle));
+  mu_assert_int_eq(3, queue->Count);
+
+  mu_check(Collection.PriorityQueue.PopMin(queue, null) == &b);
+  mu_check(Collection.PriorityQueue.PopMin(queue, null) == &c);
+  mu_check(Collection.PriorityQueue.PopMin(queue, null) == &d);
+}
+
+MU_TEST(GenericPriorityQueue_Remove__ReplacementIsSmaller__SiftsUp) {
+  U8 testBuffer[1024];
+
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  mu_assert(heap, "Unable to initialize heap.");
+  PriorityQueue* queue = Collection.PriorityQueue.Create(heap, 16);
+  mu_assert(queue, "Unable to create queue.");
+
+  // Pushed in heap order; the last entry (4) is below 3 and replaces
+  // 101, which is below 100, so it must move up
+  U32 keys[] = { 1, 100, 2, 101, 102, 3, 5, 103, 104, 105, 106, 6, 4 };
+  QueueHandle handles[13];
+  for (U32 index = 0; index < 13; index++)
+    handles[index] = Collection.PriorityQueue.Push(queue, keys[index], &keys[index]);
+
+  mu_check(Collection.PriorityQueue.Remove(queue, handles[3]));
+
+  U32 expected[] = { 1, 2, 3, 4, 5, 6, 100, 102, 103, 104, 105, 106 };
+  for (U32 index = 0; index < 12; index++) {
+    U32 key;
+    mu_check(Collection.PriorityQueue.PopMin(queue, &key));
+    mu_assert_int_eq(expected[index], key);
+  }
+}
+
+MU_TEST(GenericPriorityQueue_Remove__AlreadyRemoved__ReturnsFalse) {
+  U8 testBuffer[512];
+
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  mu_assert(heap, "Unable to initialize heap.");
+  PriorityQueue* queue = Collection.PriorityQueue.Create(heap, 4);
+  mu_assert(queue, "Unable to create queue.");
+
+  QueueHandle handle = Collection.PriorityQueue.Push(queue, 10, null);
+  Collection.PriorityQueue.Push(queue, 20, null);
+
+  mu_check(Collection.PriorityQueue.Remove(queue, handle));
+  mu_check(!Collection.PriorityQueue.Remove(queue, handle));
+  mu_assert_int_eq(1, queue->Count);
+}
+
+MU_TEST(GenericPriorityQueue_Push__AfterPop__ReusesHandle) {
+  U8 testBuffer[512];
+
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  mu_assert(heap, "Unable to initialize heap.");
+  PriorityQueue* queue = Collection.PriorityQueue.Create(heap, 1);
+  mu_assert(queue, "Unable to create queue.");
+
+  QueueHandle first = Collection.PriorityQueue.Push(queue, 10, null);
+  Collection.PriorityQueue.PopMin(queue, null);
+  QueueHandle second = Collection.PriorityQueue.Push(queue, 20, null);
+
+  mu_check(second != QUEUE_INVALID_HANDLE);
+  mu_assert_int_eq(first, second);
+}
+
+
+MU_TEST_SUITE(GenericPriorityQueue) {
+  // Create
+  MU_RUN_TEST(GenericPriorityQueue_Create__HeapIsNull__ReturnsNull);
+  MU_RUN_TEST(GenericPriorityQueue_Create__CapacityIsZero__ReturnsNull);
+  MU_RUN_TEST(GenericPriorityQueue_Create__SizeOverflows__ReturnsNull);
+  MU_RUN_TEST(GenericPriorityQueue_Create__EnoughSpace__CreatesInstance);
+
+  // Dispose
+  MU_RUN_TEST(GenericPriorityQueue_Dispose__Always__FreesAll);
+
+  // Push
+  MU_RUN_TEST(GenericPriorityQueue_Push__QueueIsFull__ReturnsInvalidHandle);
+  MU_RUN_TEST(GenericPriorityQueue_Push__AfterPop__ReusesHandle);
+
+  // PopMin
+  MU_RUN_TEST(GenericPriorityQueue_PopMin__QueueIsEmpty__ReturnsNull);
+  MU_RUN_TEST(GenericPriorityQueue_PopMin__NotEmpty__ReturnsEntriesInKeyOrder);
+
+  // PeekMin
+  MU_RUN_TEST(GenericPriorityQueue_PeekMin__NotEmpty__KeepsEntry);
+
+  // DecreaseKey
+  MU_RUN_TEST(GenericPriorityQueue_DecreaseKey__LowerKey__MovesEntryToFront);
+  MU_RUN_TEST(GenericPriorityQueue_DecreaseKey__HigherKey__ReturnsFalse);
+
+  // Remove
+  MU_RUN_TEST(GenericPriorityQueue_Remove__Queued__RemovesEntry);
+  MU_RUN_TEST(GenericPriorityQueue_Remove__ReplacementIsSmaller__SiftsUp);
+  MU_RUN_TEST(GenericPriorityQueue_Remove__AlreadyRemoved__ReturnsFalse);
+}
+
+
+
 
 int main(void) {
   MU_RUN_SUITE(GenericList);
+  MU_RUN_SUITE(GenericPriorityQueue);
 
   MU_REPORT();
 
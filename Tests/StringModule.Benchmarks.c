@@ -0,0 +1,135 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "Benchmark.h"
+
+#include "../Source/Modules/Include/String.h"
+
+
+use(String);
+
+
+static char _Buffer[128];
+
+
+// Reference: the previous String.Format, which converts one digit per
+// division and reverses the result afterwards.
+static const string _LegacyAlphabet = "0123456789abcdef";
+
+static string _Legacy_AsDecimal(U32 value, string buffer) {
+  char temp[32] = { };
+  string tempPtr = temp;
+
+  do {
+    *tempPtr++ = (value % 10) + *_LegacyAlphabet;
+    value /= 10;
+  } while(value);
+
+  String.Reverse(temp);
+
+  for (char* tempChar = temp; *tempChar; tempChar++)
+    *buffer++ = *tempChar;
+
+  return buffer;
+}
+
+static void _Legacy_Format(string destination, const string formatStr, ...) {
+  va_list argumentList;
+  va_start(argumentList, formatStr);
+
+  for (char *formatPtr = formatStr; *formatPtr; formatPtr++) {
+    if (*formatPtr != '%') {
+      *destination++ = *formatPtr;
+      continue;
+    }
+
+    if (*(formatPtr + 1) == 'd') {
+      formatPtr++;
+      destination = _Legacy_AsDecimal(va_arg(argumentList, int), destination);
+    }
+  }
+
+  *destination++ = '\0';
+  va_end(argumentList);
+}
+
+
+// Reference: the previous byte-wise GetLength and Search
+static U32 _Legacy_GetLength(string pointer) {
+  string posPtr = pointer;
+  for (;*posPtr; posPtr++)
+    ;
+
+  return posPtr - pointer;
+}
+
+static char* _Legacy_Search(char* pointer, char ch, U32 count) {
+  for (char* ptr = pointer; *ptr && count--; ptr++) {
+    if (*ptr == ch)
+      return ptr;
+  }
+
+  return null;
+}
+
+
+static char _Line[256];
+static volatile U32 _Sink;
+
+
+int main(void) {
+  printf("String.Format (time per call)\n");
+
+  // The status bar of the shell is formatted on every frame
+  BENCHMARK("Legacy: status bar", 1000000,
+	    _Legacy_Format(_Buffer, "%d of %d bytes free (%d%%)", 254312 + __benchmarkIndex, 262144, 97));
+  BENCHMARK("Format: status bar", 1000000,
+	    String.Format(_Buffer, "%d of %d bytes free (%d%%)", 254312 + __benchmarkIndex, 262144, 97));
+  BENCHMARK("FormatN: status bar", 1000000,
+	    String.FormatN(_Buffer, sizeof(_Buffer), "%u of %u bytes free (%u%%)", 254312 + __benchmarkIndex, 262144, 97));
+
+  BENCHMARK("Legacy: large number", 1000000,
+	    _Legacy_Format(_Buffer, "%d", 4000000000u - __benchmarkIndex));
+  BENCHMARK("Format: large number", 1000000,
+	    String.Format(_Buffer, "%u", 4000000000u - __benchmarkIndex));
+
+
+  for (U32 index = 0; index < sizeof(_Line) - 1; index++)
+    _Line[index] = 'a' + index % 26;
+
+  printf("\nString scans, %u chars (time per call)\n", (U32)sizeof(_Line) - 1);
+
+  BENCHMARK("Legacy: GetLength", 1000000, _Sink = _Legacy_GetLength(_Line));
+  BENCHMARK("GetLength", 1000000, _Sink = String.GetLength(_Line));
+  BENCHMARK("Legacy: Search (not found)", 1000000, _Sink = (U32)_Legacy_Search(_Line, '#', sizeof(_Line)));
+  BENCHMARK("Search (not found)", 1000000, _Sink = (U32)String.Search(_Line, '#', sizeof(_Line)));
+  BENCHMARK("SearchAny (not found)", 1000000, _Sink = (U32)String.SearchAny(_Line, "#;,", sizeof(_Line)));
+
+  return 0;
+}
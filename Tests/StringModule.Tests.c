@@ -49,9 +49,22 @@ MU_TEST(String_GetLength__NonEmptyString__ReturnsLength) {
   mu_check(String.GetLength(testString) == 10);
 }
 
+MU_TEST(String_GetLength__AnyAlignment__ReturnsLength) {
+  char testBuffer[64];
+
+  for (U32 offset = 0; offset < 4; offset++)
+    for (U32 length = 0; length < 20; length++) {
+      memset(testBuffer, 'a', sizeof(testBuffer));
+      testBuffer[offset + length] = '\0';
+
+      mu_assert_int_eq(length, String.GetLength(testBuffer + offset));
+    }
+}
+
 MU_TEST_SUITE(String_GetLength) {
   MU_RUN_TEST(String_GetLength__EmptyString__ReturnsZero);
   MU_RUN_TEST(String_GetLength__NonEmptyString__ReturnsLength);
+  MU_RUN_TEST(String_GetLength__AnyAlignment__ReturnsLength);
 }
 
 
@@ -93,8 +106,109 @@ MU_TEST(String_Format__PositiveDecimal__FormatsAsDecimal) {
   mu_check(memcmp(testBuffer, expected, 5) == 0);
 }
 
+MU_TEST(String_Format__NegativeDecimal__FormatsWithSign) {
+  char testBuffer[100] = { };
+
+  String.Format(testBuffer, "%d %i", -1234, -2147483647 - 1);
+
+  mu_assert_string_eq("-1234 -2147483648", testBuffer);
+}
+
+MU_TEST(String_Format__Unsigned__FormatsFullRange) {
+  char testBuffer[100] = { };
+
+  String.Format(testBuffer, "%u %u %u", 0, 99, 4294967295u);
+
+  mu_assert_string_eq("0 99 4294967295", testBuffer);
+}
+
+MU_TEST(String_Format__Width__PadsValues) {
+  char testBuffer[100] = { };
+
+  String.Format(testBuffer, "[%5d][%05d][%-5d][%05i][%3s][%-3c]", 42, 42, 42, -42, "a", 'b');
+
+  mu_assert_string_eq("[   42][00042][42   ][-0042][  a][b  ]", testBuffer);
+}
+
+MU_TEST(String_Format__String__InsertsText) {
+  char testBuffer[100] = { };
+
+  String.Format(testBuffer, "%s, %s!", "Hello", "World");
+
+  mu_assert_string_eq("Hello, World!", testBuffer);
+}
+
+MU_TEST(String_Format__Hex__FormatsWithPrefix) {
+  char testBuffer[100] = { };
+
+  String.Format(testBuffer, "%x %xb %xd", 0xcafe, 0x1f, 0xbeef);
+
+  mu_assert_string_eq("0x0000cafe 0x1f 0xbeef", testBuffer);
+}
+
+MU_TEST(String_Format__Percent__WritesPercentSign) {
+  char testBuffer[100] = { };
+
+  String.Format(testBuffer, "%d%%", 50);
+
+  mu_assert_string_eq("50%", testBuffer);
+}
+
 MU_TEST_SUITE(String_Format) {
   MU_RUN_TEST(String_Format__PositiveDecimal__FormatsAsDecimal);
+  MU_RUN_TEST(String_Format__NegativeDecimal__FormatsWithSign);
+  MU_RUN_TEST(String_Format__Unsigned__FormatsFullRange);
+  MU_RUN_TEST(String_Format__Width__PadsValues);
+  MU_RUN_TEST(String_Format__String__InsertsText);
+  MU_RUN_TEST(String_Format__Hex__FormatsWithPrefix);
+  MU_RUN_TEST(String_Format__Percent__WritesPercentSign);
+}
+
+
+
+// Bounded format
+
+MU_TEST(String_FormatN__TooLong__TruncatesAndTerminates) {
+  char testBuffer[8];
+  memset(testBuffer, 'x', sizeof(testBuffer));
+
+  U32 length = String.FormatN(testBuffer, 6, "%s %d", "Value", 12345);
+
+  mu_assert_int_eq(5, length);
+  mu_assert_string_eq("Value", testBuffer);
+  mu_assert_int_eq('x', testBuffer[6]);
+}
+
+MU_TEST(String_FormatN__FitsExactly__WritesAll) {
+  char testBuffer[5];
+
+  U32 length = String.FormatN(testBuffer, sizeof(testBuffer), "%u", 1234);
+
+  mu_assert_int_eq(4, length);
+  mu_assert_string_eq("1234", testBuffer);
+}
+
+MU_TEST(String_FormatN__ZeroCapacity__WritesNothing) {
+  char testBuffer[4] = "abc";
+
+  mu_assert_int_eq(0, String.FormatN(testBuffer, 0, "%d", 1));
+  mu_assert_string_eq("abc", testBuffer);
+}
+
+MU_TEST(String_FormatN__WidthTooLarge__ClipsWidth) {
+  char testBuffer[300];
+
+  U32 length = String.FormatN(testBuffer, sizeof(testBuffer), "%300u", 7);
+
+  mu_assert_int_eq(255, length);
+  mu_assert_int_eq('7', testBuffer[254]);
+}
+
+MU_TEST_SUITE(String_FormatN) {
+  MU_RUN_TEST(String_FormatN__TooLong__TruncatesAndTerminates);
+  MU_RUN_TEST(String_FormatN__FitsExactly__WritesAll);
+  MU_RUN_TEST(String_FormatN__ZeroCapacity__WritesNothing);
+  MU_RUN_TEST(String_FormatN__WidthTooLarge__ClipsWidth);
 }
 
 
@@ -114,9 +228,138 @@ MU_TEST(String_Search__NotFound__ReturnsNull) {
   mu_assert(!actual, "Pointer returned.");
 }
 
+MU_TEST(String_Search__AnyAlignment__ReturnsFirstMatch) {
+  char testBuffer[64];
+
+  for (U32 offset = 0; offset < 4; offset++)
+    for (U32 position = 0; position < 20; position++) {
+      strcpy(testBuffer + offset, "abcdefghijklmnopqrstuvwxyz");
+      testBuffer[offset + position] = '#';
+
+      char* actual = String.Search(testBuffer + offset, '#', 32);
+      mu_check(actual == testBuffer + offset + position);
+    }
+}
+
+MU_TEST(String_Search__BehindCount__ReturnsNull) {
+  char testBuffer[] = "abcdefghijklmnop#";
+
+  mu_check(!String.Search(testBuffer, '#', 16));
+  mu_check(String.Search(testBuffer, '#', 17) == testBuffer + 16);
+}
+
+MU_TEST(String_Search__BehindTerminator__ReturnsNull) {
+  char testBuffer[] = "abcdefgh\0ijklm#";
+
+  mu_check(!String.Search(testBuffer, '#', sizeof(testBuffer)));
+}
+
 MU_TEST_SUITE(String_Search) {
   MU_RUN_TEST(String_Search__Found__ReturnsPointer);
   MU_RUN_TEST(String_Search__NotFound__ReturnsNull);
+  MU_RUN_TEST(String_Search__AnyAlignment__ReturnsFirstMatch);
+  MU_RUN_TEST(String_Search__BehindCount__ReturnsNull);
+  MU_RUN_TEST(String_Search__BehindTerminator__ReturnsNull);
+}
+
+
+
+MU_TEST(String_SearchAny__Found__ReturnsFirstMatch) {
+  char testBuffer[] = "print x, y; exit";
+
+  mu_assert_string_eq(", y; exit", String.SearchAny(testBuffer, ";,", sizeof(testBuffer)));
+  mu_assert_string_eq(" x, y; exit", String.SearchAny(testBuffer, " \t", sizeof(testBuffer)));
+}
+
+MU_TEST(String_SearchAny__NotFound__ReturnsNull) {
+  char testBuffer[] = "print x, y; exit";
+
+  mu_check(!String.SearchAny(testBuffer, "#!", sizeof(testBuffer)));
+  mu_check(!String.SearchAny(testBuffer, ";", 10));
+  mu_check(!String.SearchAny(testBuffer, "", sizeof(testBuffer)));
+}
+
+MU_TEST_SUITE(String_SearchAny) {
+  MU_RUN_TEST(String_SearchAny__Found__ReturnsFirstMatch);
+  MU_RUN_TEST(String_SearchAny__NotFound__ReturnsNull);
+}
+
+
+
+MU_TEST(String_Compare__EqualStrings__ReturnsZero) {
+  char a[64];
+  char b[64];
+
+  for (U32 offset = 0; offset < 4; offset++)
+    for (U32 otherOffset = 0; otherOffset < 4; otherOffset++) {
+      strcpy(a + offset, "The quick brown fox");
+      strcpy(b + otherOffset, "The quick brown fox");
+
+      mu_assert_int_eq(0, String.Compare(a + offset, b + otherOffset));
+    }
+}
+
+MU_TEST(String_Compare__DifferentStrings__ReturnsOrder) {
+  char a[64];
+  char b[64];
+
+  for (U32 offset = 0; offset < 4; offset++)
+    for (U32 otherOffset = 0; otherOffset < 4; otherOffset++) {
+      strcpy(a + offset, "The quick brown fox");
+      strcpy(b + otherOffset, "The quick brown cat");
+
+      mu_check(String.Compare(a + offset, b + otherOffset) > 0);
+      mu_check(String.Compare(b + otherOffset, a + offset) < 0);
+    }
+
+  mu_check(String.Compare("abc", "abcd") < 0);
+  mu_check(String.Compare("abcd", "abc") > 0);
+  mu_check(String.Compare("", "a") < 0);
+  mu_check(String.Compare("\xff", "a") > 0);
+}
+
+MU_TEST_SUITE(String_Compare) {
+  MU_RUN_TEST(String_Compare__EqualStrings__ReturnsZero);
+  MU_RUN_TEST(String_Compare__DifferentStrings__ReturnsOrder);
+}
+
+
+
+MU_TEST(String_CopyN__EnoughSpace__CopiesString) {
+  char destination[64];
+  char source[64];
+
+  for (U32 offset = 0; offset < 4; offset++)
+    for (U32 otherOffset = 0; otherOffset < 4; otherOffset++) {
+      strcpy(source + otherOffset, "The quick brown fox");
+      memset(destination, 'x', sizeof(destination));
+
+      mu_assert_int_eq(19, String.CopyN(destination + offset, source + otherOffset, 32));
+      mu_assert_string_eq("The quick brown fox", destination + offset);
+      mu_assert_int_eq('x', destination[offset + 20]);
+    }
+}
+
+MU_TEST(String_CopyN__TooLong__TruncatesAndTerminates) {
+  char destination[16];
+  memset(destination, 'x', sizeof(destination));
+
+  mu_assert_int_eq(9, String.CopyN(destination, "The quick brown fox", 10));
+  mu_assert_string_eq("The quick", destination);
+  mu_assert_int_eq('x', destination[10]);
+}
+
+MU_TEST(String_CopyN__ZeroCapacity__WritesNothing) {
+  char destination[4] = "abc";
+
+  mu_assert_int_eq(0, String.CopyN(destination, "Test", 0));
+  mu_assert_string_eq("abc", destination);
+}
+
+MU_TEST_SUITE(String_CopyN) {
+  MU_RUN_TEST(String_CopyN__EnoughSpace__CopiesString);
+  MU_RUN_TEST(String_CopyN__TooLong__TruncatesAndTerminates);
+  MU_RUN_TEST(String_CopyN__ZeroCapacity__WritesNothing);
 }
 
 
@@ -124,7 +367,11 @@ int main(void) {
   MU_RUN_SUITE(String_GetLength);
   MU_RUN_SUITE(String_Reverse);
   MU_RUN_SUITE(String_Format);
+  MU_RUN_SUITE(String_FormatN);
   MU_RUN_SUITE(String_Search);
+  MU_RUN_SUITE(String_SearchAny);
+  MU_RUN_SUITE(String_Compare);
+  MU_RUN_SUITE(String_CopyN);
 
   MU_REPORT();
 
@@ -0,0 +1,369 @@
+/*
+	
+  Copyright © 2026 Maximilian Jung
+
+  Permission is hereby granted, free of charge, to any person
+  obtaining a copy of this software and associated documentation
+  files (the “Software”), to deal in the Software without
+  restriction, including without limitation the rights to use,
+  copy, modify, merge, publish, distribute, sublicense, and/or
+  sell copies of the Software, and to permit persons to whom the
+  Software is furnished to do so, subject to the following
+  conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the
+  Software.
+
+  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY
+  KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+  WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+	
+*/
+
+
+#include "MinUnit.h"
+
+#include "../Source/Modules/Include/Text.h"
+
+#include <string.h>
+
+
+use(Text);
+use(Heap);
+
+
+#define TEST_HEAP_SIZE 4096
+
+static U8 _TestHeapBuffer[TEST_HEAP_SIZE];
+static HeapArea* _TestHeap;
+
+static void _SetupHeap(void) {
+  _TestHeap = Heap.Initialize(_TestHeapBuffer, sizeof(_TestHeapBuffer));
+}
+
+
+// Copy the whole buffer into a string for comparison
+static char* _ReadAll(TextBuffer* buffer) {
+  static char text[TEST_HEAP_SIZE];
+
+  Text.CopyRange(buffer, 0, Text.GetLength(buffer), text);
+
+  return text;
+}
+
+
+
+MU_TEST(Text_Create__HeapIsNull__ReturnsNull) {
+  mu_assert(!Text.Create(null, 16), "Create returned not null.");
+}
+
+MU_TEST(Text_Create__EnoughSpace__CreatesEmptyBuffer) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+
+  mu_assert(buffer, "Unable to create buffer.");
+  mu_assert(buffer->Heap == _TestHeap, "Heap pointer was not set.");
+  mu_assert_int_eq(16, buffer->Capacity);
+  mu_assert_int_eq(0, Text.GetLength(buffer));
+  mu_assert_int_eq(0, buffer->GapStart);
+}
+
+MU_TEST(Text_Create__HeapExhausted__ReturnsNull) {
+  U8 testBuffer[256];
+  HeapArea* heap = Heap.Initialize(testBuffer, sizeof(testBuffer));
+  U32 bytesFreeBefore = heap->TotalBytesFree;
+
+  mu_assert(!Text.Create(heap, 128), "Create returned not null.");
+  mu_assert_int_eq(bytesFreeBefore, heap->TotalBytesFree);
+}
+
+
+MU_TEST(Text_Dispose__BufferExists__FreesAll) {
+  U32 bytesFreeBefore = _TestHeap->TotalBytesFree;
+
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+  Text.Insert(buffer, "abc", 3);
+  Text.Dispose(buffer);
+
+  mu_assert_int_eq(bytesFreeBefore, _TestHeap->TotalBytesFree);
+}
+
+
+MU_TEST(Text_Insert__AtEnd__AppendsText) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+
+  mu_assert_int_eq(5, Text.Insert(buffer, "Hello", 5));
+  mu_assert_int_eq(6, Text.Insert(buffer, " World", 6));
+
+  mu_assert_string_eq("Hello World", _ReadAll(buffer));
+  mu_assert_int_eq(11, buffer->GapStart);
+}
+
+MU_TEST(Text_Insert__InMiddle__KeepsSurroundingText) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+  Text.Insert(buffer, "Hello World", 11);
+
+  Text.SetCursor(buffer, 5);
+  Text.Insert(buffer, ",", 1);
+
+  mu_assert_string_eq("Hello, World", _ReadAll(buffer));
+  mu_assert_int_eq(6, buffer->GapStart);
+}
+
+MU_TEST(Text_Insert__GapTooSmall__GrowsBuffer) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 4);
+  Text.Insert(buffer, "ad", 2);
+  Text.MoveCursor(buffer, -1);
+
+  mu_assert_int_eq(20, Text.Insert(buffer, "bbbbbbbbbbbbbbbbbbbc", 20));
+
+  mu_assert(buffer->Capacity >= 22, "Buffer did not grow.");
+  mu_assert_string_eq("abbbbbbbbbbbbbbbbbbbcd", _ReadAll(buffer));
+}
+
+MU_TEST(Text_Insert__HeapExhausted__InsertsUntilFull) {
+  U8 smallHeapBuffer[256];
+  HeapArea* heap = Heap.Initialize(smallHeapBuffer, sizeof(smallHeapBuffer));
+  TextBuffer* buffer = Text.Create(heap, 8);
+
+  char text[256];
+  memset(text, 'x', sizeof(text));
+
+  mu_assert_int_eq(8, Text.Insert(buffer, text, sizeof(text)));
+  mu_assert_int_eq(8, Text.GetLength(buffer));
+}
+
+
+MU_TEST(Text_DeleteBackward__AtCursor__RemovesPrecedingChars) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+  Text.Insert(buffer, "abcdef", 6);
+  Text.SetCursor(buffer, 4);
+
+  mu_assert_int_eq(2, Text.DeleteBackward(buffer, 2));
+
+  mu_assert_string_eq("abef", _ReadAll(buffer));
+  mu_assert_int_eq(2, buffer->GapStart);
+}
+
+MU_TEST(Text_DeleteBackward__CountTooLarge__StopsAtStart) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+  Text.Insert(buffer, "abc", 3);
+  Text.SetCursor(buffer, 1);
+
+  mu_assert_int_eq(1, Text.DeleteBackward(buffer, 10));
+  mu_assert_string_eq("bc", _ReadAll(buffer));
+}
+
+
+MU_TEST(Text_DeleteForward__AtCursor__RemovesFollowingChars) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+  Text.Insert(buffer, "abcdef", 6);
+  Text.SetCursor(buffer, 1);
+
+  mu_assert_int_eq(3, Text.DeleteForward(buffer, 3));
+
+  mu_assert_string_eq("aef", _ReadAll(buffer));
+  mu_assert_int_eq(1, buffer->GapStart);
+}
+
+MU_TEST(Text_DeleteForward__CountTooLarge__StopsAtEnd) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+  Text.Insert(buffer, "abc", 3);
+  Text.SetCursor(buffer, 1);
+
+  mu_assert_int_eq(2, Text.DeleteForward(buffer, 10));
+  mu_assert_string_eq("a", _ReadAll(buffer));
+}
+
+
+MU_TEST(Text_MoveCursor__OutOfRange__ClampsPosition) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+  Text.Insert(buffer, "abc", 3);
+
+  mu_assert_int_eq(0, Text.MoveCursor(buffer, -10));
+  mu_assert_int_eq(2, Text.MoveCursor(buffer, 2));
+  mu_assert_int_eq(3, Text.MoveCursor(buffer, 10));
+  mu_assert_string_eq("abc", _ReadAll(buffer));
+}
+
+
+MU_TEST(Text_GetChar__AnyPosition__ReturnsCharAcrossGap) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+  Text.Insert(buffer, "abcd", 4);
+  Text.SetCursor(buffer, 2);
+
+  mu_assert_int_eq('a', Text.GetChar(buffer, 0));
+  mu_assert_int_eq('b', Text.GetChar(buffer, 1));
+  mu_assert_int_eq('c', Text.GetChar(buffer, 2));
+  mu_assert_int_eq('d', Text.GetChar(buffer, 3));
+  mu_assert_int_eq(0, Text.GetChar(buffer, 4));
+}
+
+
+MU_TEST(Text_CopyRange__RangeSpansGap__CopiesBothParts) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+  Text.Insert(buffer, "abcdef", 6);
+  Text.SetCursor(buffer, 3);
+
+  char destination[16];
+  mu_assert_int_eq(4, Text.CopyRange(buffer, 1, 4, destination));
+  mu_assert_string_eq("bcde", destination);
+}
+
+MU_TEST(Text_CopyRange__CountTooLarge__CopiesUntilEnd) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+  Text.Insert(buffer, "abcdef", 6);
+  Text.SetCursor(buffer, 1);
+
+  char destination[16];
+  mu_assert_int_eq(2, Text.CopyRange(buffer, 4, 100, destination));
+  mu_assert_string_eq("ef", destination);
+}
+
+
+MU_TEST(Text_GetLineCount__MultipleLines__CountsLineBreaks) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+  mu_assert_int_eq(1, Text.GetLineCount(buffer));
+
+  Text.Insert(buffer, "ab\ncde\n\nf", 9);
+  mu_assert_int_eq(4, Text.GetLineCount(buffer));
+
+  Text.SetCursor(buffer, 7);
+  Text.DeleteBackward(buffer, 1);
+  mu_assert_int_eq(3, Text.GetLineCount(buffer));
+
+  Text.SetCursor(buffer, 0);
+  Text.DeleteForward(buffer, 3);
+  mu_assert_int_eq(2, Text.GetLineCount(buffer));
+}
+
+
+MU_TEST(Text_GetLineStart__MultipleLines__ReturnsStartPositions) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+  Text.Insert(buffer, "ab\ncde\n\nf", 9);
+  Text.SetCursor(buffer, 4);
+
+  mu_assert_int_eq(0, Text.GetLineStart(buffer, 0));
+  mu_assert_int_eq(3, Text.GetLineStart(buffer, 1));
+  mu_assert_int_eq(7, Text.GetLineStart(buffer, 2));
+  mu_assert_int_eq(8, Text.GetLineStart(buffer, 3));
+  mu_assert_int_eq(9, Text.GetLineStart(buffer, 4));
+}
+
+MU_TEST(Text_GetLineOf__MultipleLines__ReturnsLineIndex) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+  Text.Insert(buffer, "ab\ncde\n\nf", 9);
+  Text.SetCursor(buffer, 4);
+
+  mu_assert_int_eq(0, Text.GetLineOf(buffer, 0));
+  mu_assert_int_eq(0, Text.GetLineOf(buffer, 2));
+  mu_assert_int_eq(1, Text.GetLineOf(buffer, 3));
+  mu_assert_int_eq(1, Text.GetLineOf(buffer, 6));
+  mu_assert_int_eq(2, Text.GetLineOf(buffer, 7));
+  mu_assert_int_eq(3, Text.GetLineOf(buffer, 8));
+  mu_assert_int_eq(3, Text.GetLineOf(buffer, 9));
+}
+
+
+
+MU_TEST(Text_GetLineStart__ManyLines__GrowsLineIndex) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+
+  for (U32 line = 0; line < 3 * TEXT_INITIAL_LINE_CAPACITY; line++)
+    Text.Insert(buffer, "ab\n", 3);
+
+  Text.SetCursor(buffer, 10);
+
+  mu_assert_int_eq(3 * TEXT_INITIAL_LINE_CAPACITY + 1, Text.GetLineCount(buffer));
+  mu_assert_int_eq(3 * 20, Text.GetLineStart(buffer, 20));
+  mu_assert_int_eq(20, Text.GetLineOf(buffer, 3 * 20 + 2));
+}
+
+MU_TEST(Text_GetLineOf__RandomEdits__MatchesScan) {
+  TextBuffer* buffer = Text.Create(_TestHeap, 16);
+  U32 seed = 1234;
+
+  for (U32 step = 0; step < 2000; step++) {
+    seed = seed * 1103515245 + 12345;
+    U32 length = Text.GetLength(buffer);
+    U32 value = seed >> 16;
+
+    switch (value % 5) {
+    case 0:
+      Text.Insert(buffer, "x\ny", 3);
+      break;
+    case 1:
+      Text.Insert(buffer, "\n", 1);
+      break;
+    case 2:
+      Text.DeleteBackward(buffer, value % 4);
+      break;
+    case 3:
+      Text.DeleteForward(buffer, value % 4);
+      break;
+    default:
+      Text.SetCursor(buffer, length ? value % (length + 1) : 0);
+      break;
+    }
+
+    if (Text.GetLength(buffer) > 600)
+      Text.DeleteForward(buffer, 300);
+  }
+
+  char* text = _ReadAll(buffer);
+  U32 length = Text.GetLength(buffer);
+  U32 line = 0;
+
+  for (U32 position = 0; position <= length; position++) {
+    mu_assert_int_eq(line, Text.GetLineOf(buffer, position));
+    if (!position || text[position - 1] == '\n')
+      mu_assert_int_eq(position, Text.GetLineStart(buffer, line));
+
+    if (position < length && text[position] == '\n')
+      line++;
+  }
+
+  mu_assert_int_eq(line + 1, Text.GetLineCount(buffer));
+}
+
+
+
+MU_TEST_SUITE(GapBuffer) {
+  MU_SUITE_CONFIGURE(&_SetupHeap, null);
+
+  MU_RUN_TEST(Text_Create__HeapIsNull__ReturnsNull);
+  MU_RUN_TEST(Text_Create__EnoughSpace__CreatesEmptyBuffer);
+  MU_RUN_TEST(Text_Create__HeapExhausted__ReturnsNull);
+  MU_RUN_TEST(Text_Dispose__BufferExists__FreesAll);
+  MU_RUN_TEST(Text_Insert__AtEnd__AppendsText);
+  MU_RUN_TEST(Text_Insert__InMiddle__KeepsSurroundingText);
+  MU_RUN_TEST(Text_Insert__GapTooSmall__GrowsBuffer);
+  MU_RUN_TEST(Text_Insert__HeapExhausted__InsertsUntilFull);
+  MU_RUN_TEST(Text_DeleteBackward__AtCursor__RemovesPrecedingChars);
+  MU_RUN_TEST(Text_DeleteBackward__CountTooLarge__StopsAtStart);
+  MU_RUN_TEST(Text_DeleteForward__AtCursor__RemovesFollowingChars);
+  MU_RUN_TEST(Text_DeleteForward__CountTooLarge__StopsAtEnd);
+  MU_RUN_TEST(Text_MoveCursor__OutOfRange__ClampsPosition);
+  MU_RUN_TEST(Text_GetChar__AnyPosition__ReturnsCharAcrossGap);
+  MU_RUN_TEST(Text_CopyRange__RangeSpansGap__CopiesBothParts);
+  MU_RUN_TEST(Text_CopyRange__CountTooLarge__CopiesUntilEnd);
+  MU_RUN_TEST(Text_GetLineCount__MultipleLines__CountsLineBreaks);
+  MU_RUN_TEST(Text_GetLineStart__MultipleLines__ReturnsStartPositions);
+  MU_RUN_TEST(Text_GetLineOf__MultipleLines__ReturnsLineIndex);
+  MU_RUN_TEST(Text_GetLineStart__ManyLines__GrowsLineIndex);
+  MU_RUN_TEST(Text_GetLineOf__RandomEdits__MatchesScan);
+}
+
+
+int main(void) {
+  MU_RUN_SUITE(GapBuffer);
+
+  MU_REPORT();
+
+  return MU_EXIT_CODE;
+}
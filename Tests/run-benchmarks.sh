@@ -0,0 +1,24 @@
+#!/bin/bash
+
+SCRIPT=$(realpath "$0")
+SCRIPTPATH=$(dirname "$SCRIPT")
+
+cd $SCRIPTPATH
+
+make clean
+make
+
+if [ $? -ne 0 ]; then
+    exit 1
+fi
+
+echo -e "\n\n==> START BENCHMARKS..."
+
+for BENCHPRG in $(ls *.Benchmarks); do
+    if [ -x $BENCHPRG ]; then
+	echo "[${BENCHPRG}]"
+	./$BENCHPRG
+    fi
+done
+
+echo -e "==> FINISH BENCHMARKS\n\n"